@@ -2,25 +2,175 @@
 #define AI_H
 
 #include "Game.h"
+#include "GameClock.h"
+#include "NeuralEvaluator.h"
+#include "OpeningBook.h"
+#include "SearchStats.h"
+#include "Tablebase.h"
+#include "ThreatSearch.h"
+#include "TranspositionTable.h"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
 #include <utility>
+#include <vector>
+
+// Playing strength, selected in GameModeWindow
+enum class Difficulty { EASY, MEDIUM, HARD };
+
+// Compute budget of one findBestMove call.
+// Weaker levels are cheaper searches, not extra work on top of a full one.
+struct SearchLimits {
+    int maxDepth = 9;                      // Plies searched, counting the root move
+    std::uint64_t maxNodes = 0;            // Node cap per move, 0 = unlimited
+    std::chrono::milliseconds maxTime{0};  // Time cap per move, 0 = unlimited
+    int rootNoise = 0;                     // Random +/- offset added to each root score
+
+    static SearchLimits forDifficulty(Difficulty difficulty);
+};
+
+// Game-theoretic value of a move, as far as the search could tell
+enum class MoveOutcome { WIN, DRAW, LOSS, HEURISTIC };
+
+// Value of one legal move, from the point of view of the side to move
+struct MoveAnalysis {
+    std::pair<int, int> move;   // Cell (row, col)
+    int score;                  // Search score, higher is better
+    MoveOutcome outcome;        // WIN / DRAW / LOSS when proven, else HEURISTIC
+    int distance;               // Plies until the game ends (WIN / LOSS / DRAW), else 0
+};
 
 class AI {
 private:
+    // Score of a win at the root; a win N plies away scores WIN_SCORE - N
+    static constexpr int WIN_SCORE = 1000;
+
     Player aiPlayer;
+    SearchLimits limits;
+    std::mt19937 rng;                      // Source of root noise
+
+    // Per-search budget state
+    int searchDepth;                       // Depth of the current iterative-deepening pass
+    bool canAbort;                         // False until one pass has completed
+    bool stopSearch;                       // Set once the node/time budget runs out
+    std::chrono::steady_clock::time_point searchStart;
+
+    // Instrumentation of the current / last search
+    SearchCounters counters;
+    SearchStats lastStats;
+
+    // Optional precomputed opening moves (not owned)
+    const OpeningBook* openingBook;
+
+    // Optional exact values of every position (not owned)
+    const Tablebase* tablebase;
+
+    // Optional network replacing the line evaluator at the horizon (not owned)
+    const NeuralEvaluator* neuralEvaluator;
+
+    // Forcing-move pre-pass, limited to the AI's search depth
+    ThreatSearch threatSearch;
+
+    // Results shared by every node, and kept across moves and games
+    TranspositionTable tt;
+
+    // Table of the AI a findBestMoves worker searches for, else nullptr
+    TranspositionTable* sharedTable;
+
+    // The table searches read and write: 'tt' unless shared
+    TranspositionTable& table();
+    const TranspositionTable& table() const;
+
+    // findBestMoves worker: the parent's settings over the parent's table
+    AI(const AI& parent, TranspositionTable& shared);
+
+    // Triangular principal-variation table, one row per ply
+    static constexpr int MAX_PLY = 11;
+    std::pair<int, int> pvTable[MAX_PLY][MAX_PLY];
+    int pvLength[MAX_PLY];
+
+    // Network first layer for the position at each ply (0 = root), only
+    // maintained while a neural evaluator is set
+    NeuralEvaluator::Accumulator accumulators[MAX_PLY];
     
-    // Core minimax algorithm with alpha-beta pruning
-    int minimax(Game game, bool isMaximizing, int alpha, int beta, int depth = 0);
-    
-    // Strategic evaluation functions
-    int evaluatePosition(const Game& game);
-    int evaluateLines(const Game& game);
+    // Negamax search with alpha-beta pruning; scores are for the side to move
+    int negamax(const Game& game, int alpha, int beta, int ply);
+
+    // Stores move + the child's line as the principal variation at this ply
+    void updatePV(int ply, const std::pair<int, int>& move);
+
+    // Continues a principal variation along stored table moves, for lines
+    // that were cut short by table hits
+    void extendPV(Game game, std::vector<std::pair<int, int>>& pv) const;
+
+    // Rebuilds the root accumulator / derives accumulators[ply + 1] from
+    // accumulators[ply] after 'move'; no-ops without a neural evaluator
+    void refreshAccumulator(const Game& game);
+    void pushAccumulator(const Game& game, const std::pair<int, int>& move, int ply);
+
+    // Resets counters and per-search flags at the start of a public call
+    // and ages the table; beginMove leaves the table alone (batches call it
+    // for every game)
+    void beginSearch();
+    void beginMove();
+    void endSearch(std::chrono::steady_clock::time_point start);
+
+    // True (and latches stopSearch) once the node or time cap is exceeded
+    bool budgetExhausted();
+
+    // Root move selection (shortcuts + negamax), called by findBestMove
+    std::pair<int, int> chooseMove(const Game& game);
     
     // Helper function to check if opponent would win with a specific move
     bool wouldOpponentWin(const Game& game, int row, int col, Player opponent);
 
 public:
-    AI(Player aiPlayer);
+    AI(Player aiPlayer, Difficulty difficulty = Difficulty::HARD);
+    AI(Player aiPlayer, const SearchLimits& limits);
     std::pair<int, int> findBestMove(Game game);
+
+    // Move for a timed game: the search gets the TimeManager budget for the
+    // side to move (or the level's own time cap, if lower), so the reply is
+    // bounded by the clock rather than by the position
+    std::pair<int, int> findBestMove(Game game, const GameClock& clock);
+
+    // Moves for many independent games in one call, each searched for its own
+    // side to move with this AI's limits. Games are spread over the shared
+    // thread pool; every worker searches into this AI's table, so results
+    // carry over between games, workers and calls.
+    // Without root noise, identical or symmetric positions are searched once.
+    // 'deadline' bounds the whole call (0 = none): late games get shorter
+    // searches, but every unfinished game still receives a legal move.
+    std::vector<std::pair<int, int>> findBestMoves(const std::vector<Game>& games,
+                                                   std::chrono::milliseconds deadline = std::chrono::milliseconds(0));
+
+    // Scores every legal move for the side to move in one search over a
+    // shared table, best move first
+    std::vector<MoveAnalysis> analyze(const Game& game);
+
+    // Book consulted before searching; nullptr disables it
+    void setOpeningBook(const OpeningBook* book);
+
+    // Tablebase answering every position without searching; nullptr disables it
+    void setTablebase(const Tablebase* table);
+
+    // Network scoring positions at the search horizon; nullptr restores the
+    // built-in line evaluator
+    void setNeuralEvaluator(const NeuralEvaluator* evaluator);
+
+    // Long-lived result cache: at most 'bytes' of memory, optionally on huge
+    // pages (Linux). Resizing or clearing forgets everything learned so far.
+    void setCacheSize(std::size_t bytes, bool hugePages = false);
+    void clearCache();
+    std::size_t getCacheSize() const;          // Bytes in use by the cache
+
+    const SearchLimits& getLimits() const;
+    void setRandomSeed(unsigned int seed);  // Makes noisy levels reproducible
+    static std::string difficultyName(Difficulty difficulty);
+
+    // Statistics of the most recent findBestMove / analyze call
+    const SearchStats& getLastSearchStats() const;
 };
 
 #endif
\ No newline at end of file
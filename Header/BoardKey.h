@@ -0,0 +1,27 @@
+// BoardKey.h
+#ifndef BOARDKEY_H
+#define BOARDKEY_H
+
+#include "Game.h"
+#include <cstdint>
+
+// Compact position keys and the 8 symmetries (rotations / reflections) of the board.
+// A key holds X's cells in bits 0-8 and O's cells in bits 9-17 (cell = row * 3 + col).
+namespace BoardKey {
+    constexpr int SYMMETRY_COUNT = 8;   // Symmetry 0 is the identity
+
+    std::uint32_t fromGame(const Game& game);           // Key of the current board
+    Game toGame(std::uint32_t key);                     // Board with those cells (X moves first)
+
+    int transformCell(int cell, int symmetry);          // Where a cell lands under a symmetry
+    int inverseSymmetry(int symmetry);                  // Symmetry that undoes the given one
+    std::uint32_t transform(std::uint32_t key, int symmetry);
+
+    int countCells(std::uint32_t cells);                // Number of set bits (popcount)
+
+    // Smallest key among all symmetric copies; 'symmetry' receives the
+    // transform that maps the given key onto the canonical one
+    std::uint32_t canonical(std::uint32_t key, int& symmetry);
+}
+
+#endif
@@ -0,0 +1,23 @@
+// CpuFeatures.h
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+// Instruction set extensions of the CPU running the program, checked once.
+// SIMD kernels are compiled for their extension whatever the build flags
+// (CPU_TARGET on GCC / Clang; MSVC needs no flag) and only called when the
+// matching check passes, so one binary runs everywhere and uses what it can.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CPU_FEATURES_X86 1
+#define CPU_TARGET(extension)
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_FEATURES_X86 1
+#define CPU_TARGET(extension) __attribute__((target(extension)))
+#endif
+
+namespace CpuFeatures {
+    bool hasSsse3();   // Byte shuffles (table lookups in a register)
+    bool hasSse42();   // Includes the CRC32 (Castagnoli) instruction
+    bool hasAvx2();    // 256-bit integer SIMD (and the OS saves its registers)
+}
+
+#endif
@@ -0,0 +1,26 @@
+// Crc32c.h
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32C (Castagnoli), the checksum framing history records. Uses the
+// SSE4.2 CRC instruction on x86 CPUs that have it (checked at run time) or
+// the ARMv8 one when compiled for it, otherwise a table-driven loop giving
+// the same results.
+namespace Crc32c {
+    // CRC of 'data' following data whose CRC was 'crc' (0 to start)
+    std::uint32_t extend(std::uint32_t crc, const void* data, std::size_t size);
+
+    inline std::uint32_t compute(const void* data, std::size_t size) {
+        return extend(0, data, size);
+    }
+
+    // The table-driven loop alone, whatever the CPU (what extend uses without the instructions)
+    std::uint32_t extendSoftware(std::uint32_t crc, const void* data, std::size_t size);
+
+    bool usesHardware();  // True if extend uses the CRC instructions on this CPU
+}
+
+#endif
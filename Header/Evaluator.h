@@ -0,0 +1,25 @@
+// Evaluator.h
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <cstdint>
+
+// Static evaluation of a non-terminal position for the side to move, used at
+// the horizon of depth-limited searches. Works on cell masks (bit = row * 3 + col).
+//
+// Every line is scored by looking up (own marks, opponent marks) in a
+// precomputed table, and the 8 lines are evaluated together: on CPUs with
+// SSSE3 (checked at run time) the per-line counts are SIMD popcounts and the
+// table lookup is a byte shuffle; otherwise a scalar loop over the same
+// tables is used.
+namespace Evaluator {
+    int evaluate(std::uint16_t mine, std::uint16_t theirs);
+
+    // Portable reference implementation (what evaluate() does without SSSE3)
+    int evaluateScalar(std::uint16_t mine, std::uint16_t theirs);
+
+    // True if evaluate() takes the SIMD path on this CPU
+    bool usesSimd();
+}
+
+#endif
@@ -20,6 +20,9 @@ private:
     // Number of moves played so far (used for detecting draw)
     int moveCount;
 
+    // Player who ran out of time, NONE while the game is decided on the board
+    Player flagged;
+
 public:
     Game();                              // Constructor initializes the game
     void reset();                        // Resets the board and turn to initial state
@@ -28,6 +31,8 @@ public:
     bool isDraw() const;                 // Returns true if the board is full and no winner
     Player getCurrentPlayer() const;     // Returns current player's turn
     Player getWinner() const;            // Returns the winning player, or NONE
+    void flagFall(Player side);          // Ends the game: 'side' lost on time
+    Player getFlagged() const;           // Returns the player who lost on time, or NONE
     std::vector<std::pair<int, int>> getAvailableMoves() const;  // Returns list of empty cells
     void printBoard() const;             // Prints board to console
     Player at(int row, int col) const;   // Gets the player at a given board position
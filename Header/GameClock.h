@@ -0,0 +1,68 @@
+// GameClock.h
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include "Game.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Time allowed per side: a starting amount plus a bonus for every move made
+struct TimeControl {
+    std::chrono::milliseconds base{0};       // Starting time per side, 0 = untimed
+    std::chrono::milliseconds increment{0};  // Added to the mover's clock after each move
+
+    bool isTimed() const;
+    std::string toString() const;            // "10s + 1s", "1 min", "Untimed"
+
+    // Choices offered in GameModeWindow, untimed first
+    static std::vector<TimeControl> presets();
+};
+
+// Chess-style clock for the two players of a Game. Only the side to move
+// loses time; pressing the clock charges it, adds the increment and starts
+// the opponent. Every call takes the current time so tests can drive it.
+class GameClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit GameClock(const TimeControl& control = TimeControl());
+
+    void start(Player side, Clock::time_point now = Clock::now()); // Starts 'side's clock (first move)
+    bool press(Clock::time_point now = Clock::now());  // Mover finished; false if its flag had already fallen
+    void stop(Clock::time_point now = Clock::now());   // Freezes both clocks (game over)
+
+    // Time left for 'side', never negative; untimed clocks report 0
+    std::chrono::milliseconds remaining(Player side, Clock::time_point now = Clock::now()) const;
+
+    // Side whose time has run out, or NONE
+    Player flagged(Clock::time_point now = Clock::now()) const;
+
+    Player running() const;                  // Side whose clock is ticking, NONE when stopped
+    const TimeControl& getControl() const;
+
+    // "1:05" for long times, "0:09.3" once tenths matter
+    static std::string format(std::chrono::milliseconds time);
+
+private:
+    TimeControl control;
+    std::chrono::milliseconds left[2];       // X, O; may go negative once flagged
+    Player side;                             // Running side
+    Clock::time_point turnStart;             // When the running side's clock started
+
+    static int index(Player side);
+};
+
+// Per-move search budgets for an engine playing on a clock
+namespace TimeManager {
+
+// Time the side to move may spend on this move, given its remaining time and
+// increment. The game phase sets how many moves the time must last; a small
+// reserve covers the time spent outside the search. Always at least 1 ms and,
+// with time left, never more than the time left.
+std::chrono::milliseconds moveBudget(const Game& game, std::chrono::milliseconds remaining,
+                                     std::chrono::milliseconds increment);
+
+}
+
+#endif
@@ -7,6 +7,9 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QFrame>
+#include <QComboBox>
+#include "AI.h"
+#include "GameClock.h"
 
 enum class GameMode {
     AI,
@@ -31,9 +34,12 @@ private slots:
 private:
     void setupUI();
     void applyStyles();
+    TimeControl selectedTimeControl() const;
 
     QString currentUsername;
     QPushButton *aiButton;
+    QComboBox *difficultyBox;
+    QComboBox *timeControlBox;
     QPushButton *playerButton;
     QPushButton *backButton;
     QLabel *titleLabel;
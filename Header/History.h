@@ -1,29 +1,233 @@
 #ifndef HISTORY_H
 #define HISTORY_H
 
-#include <string>   
-#include <vector>   
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 
-// Struct to represent one game result (e.g., "2025-06-18", "X won")
+class HistoryStore;
+class HistoryWriter;
+class MappedFile;
+struct HistorySnapshot;
+
+// Result of a game from the history owner's point of view
+enum class GameOutcome : std::uint8_t { WIN, LOSS, DRAW, UNKNOWN };
+
+// Kind of game that was played
+enum class HistoryMode : std::uint8_t { UNKNOWN, AI_EASY, AI_MEDIUM, AI_HARD, PLAYER };
+
+// Struct to represent one game result (e.g., "2025-06-18 10:30:00", "Win")
 struct GameResult {
-    std::string date;    // The date when the game was played
-    std::string result;  // The result: "X won", "O won", "Draw", etc.
+    std::string date;    // Local time the game was played; empty = now, when saved
+    std::string result;  // The result: "Win", "Loss", "Draw" (free text is classified when saved)
+    HistoryMode mode = HistoryMode::UNKNOWN;  // Opponent type / AI level
+    std::uint16_t opponent = 0;               // History::opponentId of the other player, 0 = none
+};
+
+// One game as stored on disk (16 bytes, native byte order)
+struct HistoryRecord {
+    std::int64_t timestamp;    // Seconds since 1970-01-01 UTC; sorts the history
+    std::uint8_t outcome;      // GameOutcome
+    std::uint8_t mode;         // HistoryMode
+    std::uint16_t opponent;    // History::opponentId, 0 = none
+    std::uint32_t moveOffset;  // Offset of the game's moves in a move log, NO_MOVES when not recorded
+
+    static constexpr std::uint32_t NO_MOVES = 0xFFFFFFFFu;
+};
+
+// Win / loss / draw counts of a group of games
+struct OutcomeTotals {
+    std::uint32_t games = 0;   // Every game, including ones with an unknown outcome
+    std::uint32_t wins = 0;
+    std::uint32_t losses = 0;
+    std::uint32_t draws = 0;
+
+    double winRate() const;    // wins / games, 0 without games
+    void add(GameOutcome outcome);             // Counts one more game
+    void add(const OutcomeTotals& other);      // Counts another group's games too
+};
+
+// Lifetime summary of a user's history, kept up to date as games are saved
+struct HistoryStats {
+    static constexpr int MODE_COUNT = 5;
+
+    OutcomeTotals total;
+    OutcomeTotals byMode[MODE_COUNT];  // Indexed by HistoryMode
+    std::int32_t currentStreak = 0;    // > 0: wins in a row, < 0: losses in a row, 0 after a draw
+    std::uint32_t bestWinStreak = 0;
+    std::int64_t lastPlayed = 0;       // Latest game timestamp, 0 = never played
+    std::uint32_t gamesCounted = 0;    // Records folded in so far
+
+    void add(const HistoryRecord& record);          // O(1)
+    const OutcomeTotals& forMode(HistoryMode mode) const;
 };
 
-// Class to manage saving/loading history to/from a file
+// Read-only view of a user's history as it was when opened. Records are
+// decoded one at a time, so reading k of them costs O(k) however long the
+// history is; archived records are decoded a block at a time and the last
+// block is kept, so a reader must not be shared between threads.
+class HistoryReader {
+public:
+    // Bidirectional iterator yielding decoded results, oldest first
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = GameResult;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const GameResult*;
+        using reference = GameResult;          // Decoded on access
+
+        Iterator(const HistoryReader* reader = nullptr, std::size_t index = 0);
+
+        GameResult operator*() const;
+        HistoryRecord record() const;          // Raw record, without decoding
+        std::size_t position() const;          // Index of the game, 0 = oldest
+
+        Iterator& operator++();
+        Iterator operator++(int);
+        Iterator& operator--();
+        Iterator operator--(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        const HistoryReader* reader;
+        std::size_t index;
+    };
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+
+    HistoryReader();
+    explicit HistoryReader(const std::string& path);  // Per-user .bin file of older versions; empty if missing or damaged
+    ~HistoryReader();
+    HistoryReader(HistoryReader&& other) noexcept;
+    HistoryReader& operator=(HistoryReader&& other) noexcept;
+
+    std::size_t size() const;
+    bool empty() const;
+    HistoryRecord record(std::size_t index) const;     // index < size()
+    GameResult at(std::size_t index) const;            // index < size()
+
+    // Index of the first game played at or after 'timestamp', size() if
+    // none; a binary search, as records are sorted by time
+    std::size_t lowerBound(std::int64_t timestamp) const;
+
+    // Outcomes of the games played in [from, to). Archived blocks outside
+    // the range are skipped and ones inside it counted from their header
+    OutcomeTotals totals(std::int64_t from, std::int64_t to) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+    ReverseIterator rbegin() const;                    // Newest first
+    ReverseIterator rend() const;
+
+private:
+    std::unique_ptr<MappedFile> file;
+    const unsigned char* records;              // Uncompressed records, after the archived ones
+    std::size_t recordCount;                   // Of those
+    std::size_t recordStride;                  // Bytes from one record to the next
+    const unsigned char* archive;              // HistoryArchive blocks of the oldest records
+    std::size_t archiveSize;
+    std::vector<std::size_t> blockOffsets;     // Of every (full) block in 'archive'
+    mutable std::size_t cachedBlock;           // Block decoded last, blockOffsets.size() if none
+    mutable std::vector<HistoryRecord> cachedRecords;
+
+    std::size_t archivedCount() const;
+    const std::vector<HistoryRecord>& block(std::size_t index) const;  // Decoded; empty if damaged
+
+    friend class HistoryStore;
+    HistoryReader(std::unique_ptr<MappedFile> file, const unsigned char* records, std::size_t count,
+                  std::size_t stride, const unsigned char* archive = nullptr, std::size_t archiveSize = 0);
+};
+
+// Class to manage saving/loading a user's history.
+// Games are stored as fixed-size records in a HistoryStore, which
+// also keeps a summary of all games; reads map the store, so opening costs
+// O(1) and records need no parsing. Per-user files of older versions
+// (history_<user>.bin, or text in history_<user>.txt) are moved into the
+// store on first access and kept with a .migrated suffix. The summary,
+// count and latest games come from the store's cache, so showing a history
+// again costs a memory lookup. With a HistoryWriter, saving only queues
+// the result and the writer's thread stores it.
 class History {
 private:
-    std::string filename;  // The name of the file where this user's history is stored
+    std::string username;        // Owner: key in the store, also needed to classify legacy result text
+    HistoryWriter* writer;       // Stores saved results in the background, nullptr = save in place
+    HistoryStore* store;         // Where the games are kept (not owned)
+    mutable bool migrationChecked;
+
+    friend class HistoryWriter;
+
+    // Moves the per-user files of older versions into the store once
+    void migrate() const;
+
+    // Stores records in one append and folds them into the summary
+    bool commit(const std::vector<HistoryRecord>& records, bool sync) const;
+
+    HistoryRecord toRecord(const GameResult& res, std::int64_t fallbackTime) const;
 
 public:
-    // Constructor: sets the filename based on username
-    History(const std::string& username);
+    // Constructor: history of 'username' in 'store' (HistoryStore::shared()
+    // when not given); results are saved through 'writer' when given
+    History(const std::string& username, HistoryWriter* writer = nullptr, HistoryStore* store = nullptr);
 
-    // Appends a single result to the history file
-    void saveResult(const GameResult& res);
+    // Appends a single result to the history (or queues it on the writer);
+    // false if it could not be stored. Queued results always return true:
+    // the writer's flush reports those that fail
+    bool saveResult(const GameResult& res);
 
-    // Loads all results from the history file into a vector
+    // Waits until results queued on the writer are stored; reads do this first
+    void flush() const;
+
+    // Loads all results from the history into a vector
     std::vector<GameResult> loadHistory() const;
+
+    // Number of games played, without reading them
+    std::size_t count() const;
+
+    // Up to 'count' results starting at game 'offset' (0 = oldest), oldest first
+    std::vector<GameResult> loadRange(std::size_t offset, std::size_t count) const;
+
+    // The last 'n' games (or fewer), oldest first
+    std::vector<GameResult> loadLatest(std::size_t n) const;
+
+    // Streams the history as it is now; games saved later are not included
+    HistoryReader reader() const;
+
+    // Games played in [from, to) (timestamps as from parseDate), oldest first;
+    // found by binary search, so the cost is O(log n + results)
+    std::vector<GameResult> query(std::int64_t from, std::int64_t to) const;
+
+    // Lifetime totals, streaks and last game, without reading the history
+    HistoryStats getStats() const;
+
+    // Lifetime stats, game count and latest games in one (cached) lookup
+    HistorySnapshot snapshot() const;
+
+    // Outcomes of the games played in [from, to), e.g. "this month"
+    OutcomeTotals totals(std::int64_t from, std::int64_t to) const;
+
+    // Recomputes the checksum of every record; false if the history is damaged
+    bool verify() const;
+
+    // Classifies result text ("Win", "You win! 🎉", "<name> wins!", "It's a draw!", ...)
+    GameOutcome parseOutcome(const std::string& text) const;
+
+    static std::string outcomeName(GameOutcome outcome);     // "Win", "Loss", "Draw", "Unknown"
+    static GameResult toResult(const HistoryRecord& record); // Decodes a stored record
+    static std::uint16_t opponentId(const std::string& name); // Stable 16-bit id, 0 for no name
+
+    // "YYYY-MM-DD[ hh:mm[:ss]]" in local time <-> seconds since 1970 UTC.
+    // Stored times are UTC, so daylight saving changes never reorder games
+    static bool parseDate(const std::string& date, std::int64_t& timestamp);
+    static std::string formatDate(std::int64_t timestamp);
+    static std::int64_t currentTime();  // Now, on the same scale, e.g. for "the last 7 days"
+
+    // Deletes every game of 'username' from 'store' (the shared one when not
+    // given), including files of older versions
+    static void remove(const std::string& username, HistoryStore* store = nullptr);
 };
 
 #endif
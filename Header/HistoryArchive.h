@@ -0,0 +1,48 @@
+// HistoryArchive.h
+#ifndef HISTORYARCHIVE_H
+#define HISTORYARCHIVE_H
+
+#include "History.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Columnar encoding of cold history records. A block holds up to
+// BLOCK_RECORDS records, sorted by time, one column at a time:
+//   - timestamps as zigzag varint deltas (the first one from minTime),
+//   - outcomes bit-packed two bits each,
+//   - modes, opponents and move offsets dictionary-encoded: the distinct
+//     values as varints, then each record's index bit-packed in as few
+//     bits as the dictionary needs (none for a single value).
+// A fixed-size header in front gives the time span and outcome totals, so
+// range scans skip whole blocks and aggregates over whole blocks need no
+// decoding. A typical block takes 2-3 bytes per game instead of 16.
+namespace HistoryArchive {
+    constexpr std::size_t BLOCK_RECORDS = 256;
+
+    struct BlockInfo {
+        std::uint32_t count;         // Records in the block
+        std::uint32_t size;          // Bytes of columns after this header
+        std::int64_t minTime;
+        std::int64_t maxTime;
+        OutcomeTotals totals;        // Of every record in the block
+        std::uint32_t crc;           // CRC-32C of the bytes above and the columns
+        std::uint32_t reserved;
+    };
+
+    // Appends one block holding 'count' records (at most BLOCK_RECORDS)
+    void encodeBlock(const HistoryRecord* records, std::size_t count, std::vector<unsigned char>& out);
+
+    // Header of the block at 'data'; false if the block does not fit in 'available'
+    bool readInfo(const unsigned char* data, std::size_t available, BlockInfo& info);
+
+    // Records of the block at 'data' (replacing 'records'); false if it is damaged
+    bool decodeBlock(const unsigned char* data, std::size_t available, std::vector<HistoryRecord>& records);
+
+    // Bytes taken by the block with this header
+    inline std::size_t blockSize(const BlockInfo& info) {
+        return sizeof(BlockInfo) + info.size;
+    }
+}
+
+#endif
@@ -0,0 +1,78 @@
+// HistoryCache.h
+#ifndef HISTORYCACHE_H
+#define HISTORYCACHE_H
+
+#include "History.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// What a history view shows of a user: the summary and the latest games
+struct HistorySnapshot {
+    HistoryStats stats;
+    std::size_t count = 0;                // Games in the whole history
+    std::vector<HistoryRecord> latest;    // The newest of them, oldest first
+};
+
+// Size-bounded, least-recently-used cache of HistorySnapshots. The
+// HistoryStore keeps one, updates cached users as their games are stored
+// and forgets them when they are removed, so repeated history views are
+// memory lookups. Safe to use from several threads.
+class HistoryCache {
+public:
+    struct Options {
+        std::size_t capacityBytes = 1 << 20;  // Users are evicted, oldest use first, beyond this
+        std::size_t recentGames = 64;         // Latest games kept per user
+    };
+
+    HistoryCache();
+    explicit HistoryCache(const Options& options);
+
+    HistoryCache(const HistoryCache&) = delete;
+    HistoryCache& operator=(const HistoryCache&) = delete;
+
+    // Copies the user's snapshot and marks it used; false if not cached
+    bool lookup(const std::string& username, HistorySnapshot& snapshot);
+
+    // Caches (or replaces) the user's snapshot, keeping its recentGames newest games
+    void insert(const std::string& username, HistorySnapshot snapshot);
+
+    // Write-through of games just stored, newer than the cached ones; users
+    // not in the cache are left out
+    void append(const std::string& username, const HistoryStats& stats, std::size_t count,
+                const std::vector<HistoryRecord>& records);
+
+    void erase(const std::string& username);
+    void clear();
+
+    std::size_t size() const;             // Users cached
+    std::size_t bytes() const;            // Memory they take, roughly
+    std::uint64_t hits() const;
+    std::uint64_t misses() const;
+    std::size_t recentGames() const;
+
+private:
+    struct Node {
+        std::string username;
+        HistorySnapshot snapshot;
+        std::size_t bytes;
+    };
+
+    Options options;
+    std::list<Node> order;                // Most recently used first
+    std::unordered_map<std::string, std::list<Node>::iterator> nodes;
+    std::size_t usedBytes;
+    std::uint64_t hitCount;
+    std::uint64_t missCount;
+    mutable std::mutex mutex;
+
+    static std::size_t nodeBytes(const Node& node);
+    void trim(std::vector<HistoryRecord>& latest) const;
+    void evict();                         // Drops least recently used users until within capacity
+};
+
+#endif
@@ -0,0 +1,112 @@
+// HistoryStore.h
+#ifndef HISTORYSTORE_H
+#define HISTORYSTORE_H
+
+#include "History.h"
+#include "HistoryCache.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Leaderboard;
+struct LeaderboardEntry;
+
+// Every user's history in a fixed number of shard files, picked by a hash
+// of the username, instead of one file per user.
+//
+// A shard starts with a header and an open-addressing index of its users.
+// Each index entry holds the user's name, lifetime stats and the place of
+// the user's records: one contiguous region, sorted by time, that is moved
+// to the end of the file with twice the room when it fills up. Looking a user up maps the
+// shard and probes the index, so it costs O(1) whatever the number of
+// users or games. Data is always written before the header and index entry
+// that point to it; a crash in between only leaves unreferenced bytes.
+//
+// Once a user's region holds 512 records, whole blocks of the oldest are
+// compacted into a columnar archive region (see HistoryArchive.h) that is
+// extended the same way, leaving at least 256 records as frames. Regions
+// left behind by moves are reclaimed once they are half of the shard, by
+// writing the live data to a new file that replaces the old one.
+//
+// Each record is framed with its length and a CRC-32C. Appends are synced
+// at least every 64 records (and every structural change always), and the
+// index entry remembers how many records are known to be on disk, so after
+// a crash only the records since then are checked and the history is cut
+// at the last intact one. Recovery time does not grow with the history.
+//
+// Summaries and latest games of recently viewed users are kept in a
+// HistoryCache, updated as their games are stored, so showing a history
+// again does not touch the disk.
+//
+// The store's directory also holds the Leaderboard of its users.
+//
+// Writes within one process are serialized per shard; concurrent writers in
+// several processes are not supported.
+class HistoryStore {
+public:
+    static constexpr int SHARD_COUNT = 64;
+
+    explicit HistoryStore(const std::string& directory = "history",
+                          const HistoryCache::Options& cacheOptions = HistoryCache::Options());
+    ~HistoryStore();
+
+    HistoryStore(const HistoryStore&) = delete;
+    HistoryStore& operator=(const HistoryStore&) = delete;
+
+    // Adds records to the user's history (creating the user on first use)
+    // and folds them into the stats. Records older than the user's latest
+    // one are merged into place, so the history stays sorted by time;
+    // 'sync' forces each step to disk. The user's new stats go to 'updated'
+    // when given
+    bool append(const std::string& username, const std::vector<HistoryRecord>& records,
+                bool sync = false, HistoryStats* updated = nullptr);
+
+    // Snapshot of the user's records; empty for unknown users
+    HistoryReader open(const std::string& username) const;
+
+    // Stored stats of the user; false (and empty stats) for unknown users
+    bool stats(const std::string& username, HistoryStats& stats) const;
+
+    // Stats, game count and latest games of the user, from the cache when
+    // it has them; empty for unknown users
+    HistorySnapshot snapshot(const std::string& username) const;
+
+    // Checks the CRC of every record of the user; true for unknown users
+    bool verify(const std::string& username) const;
+
+    // Forgets the user and all of their games; false if they had none
+    bool remove(const std::string& username);
+
+    std::string shardPath(const std::string& username) const;
+    const std::string& getDirectory() const;
+    HistoryCache& getCache() const;
+
+    // Ranking of the store's users (leaderboard.db in the directory),
+    // opened on first use; History keeps it up to date. Without a board file
+    // it is filled from every user's stored stats, read from the shard
+    // indexes without touching any records.
+    Leaderboard& leaderboard();
+
+    // Store in the working directory, used by default by History
+    static HistoryStore& shared();
+
+private:
+    std::string directory;
+    mutable std::mutex shardLocks[SHARD_COUNT];
+    mutable HistoryCache cache;             // Written under the user's shard lock
+    std::unique_ptr<Leaderboard> board;
+    std::once_flag boardOpened;
+
+    static std::uint64_t nameHash(const std::string& username);
+    std::string shardFile(int shard) const;
+    std::vector<LeaderboardEntry> storedTotals() const;  // Every user's totals, from the indexes
+
+    // Callers hold the shard lock
+    HistoryReader openLocked(const std::string& username, std::uint64_t hash) const;
+    bool statsLocked(const std::string& username, std::uint64_t hash, HistoryStats& stats) const;
+};
+
+#endif
@@ -0,0 +1,75 @@
+// HistoryWriter.h
+#ifndef HISTORYWRITER_H
+#define HISTORYWRITER_H
+
+#include "History.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Background thread storing results for any number of Histories. Queued
+// results are committed in batches: each user's share of a batch is one
+// write of all its records plus one header update. Saving a result only
+// queues it, so game-end handling never waits on disk. A commit that fails
+// is retried; results still not stored after the last attempt are counted
+// as failed and reported by flush.
+class HistoryWriter {
+public:
+    struct Options {
+        std::size_t queueCapacity = 1024;  // Results waiting at most; a full queue makes save block
+        std::size_t maxBatch = 256;        // Results committed together at most
+        bool syncEachBatch = false;        // fsync every batch before reporting it stored
+        int maxAttempts = 3;               // Tries per user and batch before giving up on the results
+        std::chrono::milliseconds retryDelay{100};  // Pause before each retry
+    };
+
+    HistoryWriter();
+    explicit HistoryWriter(const Options& options);
+    ~HistoryWriter();                      // Stores everything still queued, then joins
+
+    HistoryWriter(const HistoryWriter&) = delete;
+    HistoryWriter& operator=(const HistoryWriter&) = delete;
+
+    // Queues a record for 'history' (copied, so the caller's History may go
+    // away); History::saveResult calls this
+    void submit(const History& history, const HistoryRecord& record);
+
+    // Blocks until every result submitted before the call is stored or given
+    // up on; false if results failed meanwhile (see failedResults)
+    bool flush();
+
+    std::uint64_t batchesCommitted() const;  // Group commits done so far
+    std::uint64_t failedResults() const;     // Results that could not be stored
+
+    // Writer used by the windows, created on first use. main flushes it on
+    // aboutToQuit; it is also destroyed before the shared store.
+    static HistoryWriter& shared();
+
+private:
+    struct Pending {
+        History history;
+        HistoryRecord record;
+    };
+
+    Options options;
+    std::deque<Pending> queue;
+    mutable std::mutex mutex;
+    std::condition_variable workReady;     // Signals the worker: new results or shutdown
+    std::condition_variable spaceFree;     // Signals submit: the queue has room
+    std::condition_variable committed;     // Signals flush: a batch is stored
+    std::uint64_t submittedCount;
+    std::uint64_t committedCount;          // Results stored or given up on
+    std::uint64_t failedCount;
+    std::uint64_t batches;
+    bool stopping;
+    std::thread worker;
+
+    void workerLoop();
+    std::size_t commitBatch(std::deque<Pending>& batch);  // Returns the results that failed
+};
+
+#endif
@@ -0,0 +1,96 @@
+// Leaderboard.h
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "History.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One user's standing
+struct LeaderboardEntry {
+    std::string username;
+    OutcomeTotals totals;       // Every stored game of the user
+    std::size_t rank = 0;       // 1 = best
+
+    std::uint32_t points() const;  // 2 per win, 1 per draw
+};
+
+// Ranking of every user with stored games, kept up to date as games are
+// saved instead of being recomputed from the histories. Users are ordered
+// by points, then wins, then fewer games, then name, in an indexable skip
+// list: each link knows how many users it skips, so updating a user, their
+// rank and the top k all cost O(log n) (plus k).
+//
+// Updates are appended to a log file as the user's new totals, so replaying
+// it restores the board; the log is rewritten with one record per user once
+// it is mostly superseded records. The log is not synced: a lost update is
+// put right by the user's next game, as totals are absolute.
+class Leaderboard {
+public:
+    explicit Leaderboard(const std::string& path);
+    ~Leaderboard();
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    // Sets the user's totals (users without games leave the board)
+    void update(const std::string& username, const OutcomeTotals& totals);
+
+    // Takes the user off the board; false if they were not on it
+    bool remove(const std::string& username);
+
+    // Replaces the whole board with 'entries' (ranks are ignored). The log
+    // is written anew and renamed over the old one, so a crash keeps either
+    // board whole.
+    void assign(const std::vector<LeaderboardEntry>& entries);
+
+    // The best 'count' users, best first
+    std::vector<LeaderboardEntry> top(std::size_t count) const;
+
+    // The user's standing; false if they are not on the board
+    bool find(const std::string& username, LeaderboardEntry& entry) const;
+
+    std::size_t size() const;
+    const std::string& getPath() const;
+
+private:
+    static constexpr int MAX_LEVEL = 16;  // Enough for 4^16 users at p = 1/4
+
+    struct Node {
+        std::string username;
+        OutcomeTotals totals;
+        int level;
+        Node* next[MAX_LEVEL];
+        std::size_t width[MAX_LEVEL];     // Users from here to next[i], that one included
+    };
+
+    std::string path;
+    Node head;
+    std::size_t userCount;
+    std::unordered_map<std::string, std::unique_ptr<Node>> users;
+    std::mt19937 random;                  // Fixed seed: node levels need no unpredictability
+    std::ofstream log;
+    std::size_t logRecords;               // Records in the log, superseded ones included
+    mutable std::mutex mutex;
+
+    void clearLinks();                    // Empties the list, not the map
+    static bool ranksBefore(const Node& a, const Node& b);
+    int randomLevel();
+    void link(Node* node);
+    void unlink(Node* node);
+    std::size_t rankOf(const Node* node) const;
+
+    void load();
+    void writeRecord(std::ostream& out, const std::string& username, const OutcomeTotals& totals, bool removed);
+    void logUpdate(const std::string& username, const OutcomeTotals& totals, bool removed);
+    void compact();                       // Rewrites the log with one record per user
+};
+
+#endif
@@ -10,8 +10,10 @@
 #include <QFrame>
 #include <QMenuBar>
 #include <QStatusBar>
+#include <QTimer>
 #include "Game.h"
 #include "AI.h"
+#include "GameClock.h"
 #include "History.h"
 
 
@@ -19,15 +21,18 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    MainWindow(const QString& username, QWidget* parent = nullptr);
+    MainWindow(const QString& username, Difficulty difficulty = Difficulty::HARD,
+               const TimeControl& timeControl = TimeControl(), QWidget* parent = nullptr);
 
 private slots:
     void handleCellClick();
     void updateBoard();
     void newGame();
     void showHistory();
+    void showLeaderboard();
     void showAbout();
     void goBack();
+    void updateClock();
 
 private:
     void setupUI();
@@ -41,14 +46,22 @@ private:
     QLabel* statusLabel;
     QLabel* scoreLabel;
     QLabel* playerLabel;
+    QLabel* clockLabel;
     QPushButton* newGameBtn;
     QPushButton* historyBtn;
+    QPushButton* leaderboardBtn;
     QPushButton* backBtn;
     QFrame* gameFrame;
     QFrame* controlFrame;
 
     Game game;
+    Difficulty difficulty;
+    TimeControl timeControl;
+    GameClock clock;
+    QTimer* clockTimer;
     AI ai;
+    OpeningBook openingBook;
+    Tablebase tablebase;
     QString user;
     History history;
 
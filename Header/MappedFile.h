@@ -0,0 +1,35 @@
+// MappedFile.h
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, file mapping on Windows).
+// Opening costs O(1) regardless of file size; pages are loaded on first touch.
+class MappedFile {
+private:
+    const unsigned char* mappedData;   // Start of the mapping, nullptr when closed or empty
+    std::size_t mappedSize;            // Length of the file in bytes
+    bool opened;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);   // False if the file is missing or cannot be mapped
+    void close();
+
+    bool isOpen() const;
+    const unsigned char* data() const;
+    std::size_t size() const;
+};
+
+#endif
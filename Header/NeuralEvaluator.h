@@ -0,0 +1,70 @@
+// NeuralEvaluator.h
+#ifndef NEURALEVALUATOR_H
+#define NEURALEVALUATOR_H
+
+#include "Game.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Small quantized MLP scoring positions for the side to move, an alternative
+// to the hand-written line evaluator (see Evaluator.h).
+//
+// Inputs are 18 board features seen from one player's side: own marks on
+// cells 0-8, opponent marks on cells 9-17. The first layer is kept as an
+// accumulator per point of view and updated one mark at a time, so a search
+// pays for a full layer only at the root. Inference is int16 arithmetic:
+// AVX2 on CPUs that have it (checked at run time), otherwise a scalar loop
+// giving the same results.
+class NeuralEvaluator {
+public:
+    static constexpr int INPUTS = 18;
+    static constexpr int HIDDEN = 32;
+    static constexpr int ACTIVATION_MAX = 127;              // Clipped ReLU range is [0, 127]
+    static constexpr int OUTPUT_DIVISOR = ACTIVATION_MAX * 64;
+    static constexpr int MAX_SCORE = 500;                   // Outputs are clamped below win scores
+
+    // Quantized parameters, in the order stored in the weights file
+    struct Weights {
+        alignas(32) std::array<std::int16_t, INPUTS * HIDDEN> inputWeights{};  // [feature * HIDDEN + unit]
+        alignas(32) std::array<std::int16_t, HIDDEN> hiddenBias{};
+        alignas(32) std::array<std::int16_t, HIDDEN> outputWeights{};
+        std::int32_t outputBias = 0;
+    };
+
+    // First-layer sums for both points of view: [0] X's, [1] O's
+    struct Accumulator {
+        alignas(32) std::int16_t values[2][HIDDEN];
+    };
+
+private:
+    Weights net;
+
+    // Adds (sign = 1) or subtracts (sign = -1) one feature row
+    void applyFeature(std::int16_t* values, int feature, int sign) const;
+
+public:
+    NeuralEvaluator();                               // All-zero network, scores everything 0
+    explicit NeuralEvaluator(const Weights& weights);
+
+    bool load(const std::string& path);              // False if missing or not a weights file
+    bool save(const std::string& path) const;
+    const Weights& getWeights() const;
+    void setWeights(const Weights& weights);
+
+    // Accumulator maintenance: full rebuild, or one mark made / unmade
+    void refresh(Accumulator& accumulator, std::uint16_t xCells, std::uint16_t oCells) const;
+    void addMark(Accumulator& accumulator, Player player, int cell) const;
+    void removeMark(Accumulator& accumulator, Player player, int cell) const;
+
+    // Score for 'toMove', in the same units as the search (higher is better)
+    int evaluate(const Accumulator& accumulator, Player toMove) const;
+    int evaluateScalar(const Accumulator& accumulator, Player toMove) const;
+
+    // Convenience: refresh + evaluate for a position given as cell masks
+    int evaluate(std::uint16_t mine, std::uint16_t theirs) const;
+
+    static bool usesSimd();                          // True if this CPU runs the AVX2 kernels
+};
+
+#endif
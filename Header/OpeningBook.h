@@ -0,0 +1,47 @@
+// OpeningBook.h
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "Game.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// One precomputed position (8 bytes on disk, little-endian)
+struct BookEntry {
+    std::uint32_t key;      // Canonical (symmetry-reduced) position key, see BoardKey
+    std::uint8_t move;      // Best cell for the side to move, in canonical orientation
+    std::int8_t outcome;    // 1 = win, 0 = draw, -1 = loss for the side to move
+    std::uint16_t depth;    // Plies the building search looked ahead
+};
+
+// Sorted, memory-mapped table of best moves for early positions.
+// Built offline by tools/BookBuilder; lookups are a binary search over the
+// mapped file, so opening it costs nothing and probing needs no parsing.
+class OpeningBook {
+private:
+    MappedFile file;
+    const BookEntry* entries;   // Points into the mapping
+    std::size_t entryCount;
+
+public:
+    OpeningBook();
+
+    bool open(const std::string& path);     // False if missing or not a valid book
+    void close();
+    bool isOpen() const;
+    std::size_t size() const;               // Number of positions in the book
+
+    // Looks up the position; on a hit stores the book move for 'game'
+    bool probe(const Game& game, std::pair<int, int>& move) const;
+
+    // Solves every distinct position reachable within 'plies' moves
+    static std::vector<BookEntry> build(int plies);
+
+    // Sorts the entries and writes them in book format
+    static bool write(const std::string& path, std::vector<BookEntry> entries);
+};
+
+#endif
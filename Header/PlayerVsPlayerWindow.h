@@ -9,21 +9,26 @@
 #include <QGridLayout>
 #include <QFrame>
 #include <QMessageBox>
+#include <QTimer>
 #include "Game.h"
+#include "GameClock.h"
 #include "History.h"
 
 class PlayerVsPlayerWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    PlayerVsPlayerWindow(const QString& username, QWidget* parent = nullptr);
+    PlayerVsPlayerWindow(const QString& username, const TimeControl& timeControl = TimeControl(),
+                         QWidget* parent = nullptr);
 
 private slots:
     void handleCellClick();
     void updateBoard();
     void newGame();
     void showHistory();
+    void showLeaderboard();
     void goBack();
+    void updateClock();
 
 private:
     void setupUI();
@@ -39,13 +44,18 @@ private:
     QLabel* scoreLabel;
     QLabel* playerLabel;
     QLabel* currentPlayerLabel;
+    QLabel* clockLabel;
     QPushButton* newGameBtn;
     QPushButton* historyBtn;
+    QPushButton* leaderboardBtn;
     QPushButton* backBtn;
     QFrame* gameFrame;
     QFrame* controlFrame;
 
     Game game;
+    TimeControl timeControl;
+    GameClock clock;
+    QTimer* clockTimer;
     QString user;
     History history;
 
@@ -0,0 +1,56 @@
+// ProofSolver.h
+#ifndef PROOFSOLVER_H
+#define PROOFSOLVER_H
+
+#include "Game.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Game-theoretic value of a position for the side to move
+enum class ProofResult { WIN, DRAW, LOSS, UNKNOWN };
+
+// Depth-first proof-number (df-pn) solver.
+// Proves the exact value of a position instead of scoring it: one run asks
+// "can the side to move force a win?", a second one "can it avoid losing?".
+// Proof / disproof numbers live in a fixed-size table, so memory stays
+// bounded however large the proof tree is.
+class ProofSolver {
+private:
+    static constexpr std::uint32_t INF = 0x3FFFFFFF;   // Proof number of a disproven goal
+
+    struct Entry {
+        std::uint32_t key = 0;     // Position key (BoardKey), valid when work > 0
+        std::uint32_t pn = 1;      // Proof number
+        std::uint32_t dn = 1;      // Disproof number
+        std::uint32_t work = 0;    // Nodes spent on this entry, used for replacement
+    };
+
+    std::vector<Entry> table;
+    std::size_t mask;
+    std::uint64_t maxNodes;        // 0 = unlimited
+    std::uint64_t nodeCount;
+    bool aborted;
+
+    Player attacker;               // Side whose goal is being proven
+    bool drawIsSuccess;            // Goal is "not lose" instead of "win"
+
+    void lookup(std::uint32_t key, std::uint32_t& pn, std::uint32_t& dn) const;
+    void store(std::uint32_t key, std::uint32_t pn, std::uint32_t dn, std::uint64_t work);
+    bool terminalValue(const Game& game, std::uint32_t& pn, std::uint32_t& dn) const;
+    void mid(const Game& game, std::uint32_t thpn, std::uint32_t thdn,
+             std::uint32_t& pn, std::uint32_t& dn);
+    bool prove(const Game& game, bool drawCounts, bool& proven);
+
+public:
+    explicit ProofSolver(std::size_t tableEntries = 1 << 16, std::uint64_t maxNodes = 0);
+
+    // Exact value for the side to move, UNKNOWN if the node cap was hit
+    ProofResult solve(const Game& game);
+
+    std::uint64_t nodes() const;       // Nodes expanded by the last solve
+    std::size_t tableSize() const;     // Number of table slots
+    static const char* resultName(ProofResult result);
+};
+
+#endif
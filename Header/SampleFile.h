@@ -0,0 +1,84 @@
+// SampleFile.h
+#ifndef SAMPLEFILE_H
+#define SAMPLEFILE_H
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One labelled position from self-play (8 bytes on disk, little-endian)
+struct TrainingSample {
+    std::uint32_t key;      // Position before the move, see BoardKey
+    std::int16_t value;     // Search value of the played move for the side to move
+    std::uint8_t move;      // Cell played (row * 3 + col)
+    std::int8_t outcome;    // Final result for the side to move: 1 win, 0 draw, -1 loss
+};
+
+// Location of one chunk of samples in the file
+struct SampleChunk {
+    std::uint64_t offset;       // Byte offset of the chunk's first sample
+    std::uint32_t sampleCount;
+    std::uint32_t gameCount;    // Games are never split across chunks
+};
+
+// Streams samples to disk in fixed-size chunks. Only the current chunk and
+// the chunk index are held in memory, so runs of any length stay bounded.
+// close() appends the index and a footer; a file without them is rejected
+// by SampleReader.
+class SampleWriter {
+private:
+    std::ofstream out;
+    std::vector<TrainingSample> chunk;      // Samples not yet written
+    std::uint32_t chunkGames;
+    std::vector<SampleChunk> index;
+    std::size_t chunkCapacity;
+    std::uint64_t offset;                   // Current end of the file
+    std::uint64_t samplesWritten;
+    std::uint64_t gamesWritten;
+
+    bool flushChunk();
+
+public:
+    // Capacity in samples; a game (at most 9 samples) always fits in one chunk
+    explicit SampleWriter(std::size_t chunkCapacity = 4096);
+    ~SampleWriter();                        // Closes the file if still open
+
+    SampleWriter(const SampleWriter&) = delete;
+    SampleWriter& operator=(const SampleWriter&) = delete;
+
+    bool open(const std::string& path);
+    bool addGame(const std::vector<TrainingSample>& samples);
+    bool close();                           // Flushes, then writes index and footer
+    bool isOpen() const;
+
+    std::uint64_t sampleCount() const;      // Samples added so far
+    std::uint64_t gameCount() const;
+};
+
+// Memory-mapped view of a finished sample file; chunks are read in place
+class SampleReader {
+private:
+    MappedFile file;
+    const SampleChunk* index;               // Points into the mapping
+    std::size_t chunks;
+    std::uint64_t samples;
+    std::uint64_t games;
+
+public:
+    SampleReader();
+
+    bool open(const std::string& path);     // False if missing, truncated or not a sample file
+    void close();
+
+    std::size_t chunkCount() const;
+    std::uint64_t sampleCount() const;
+    std::uint64_t gameCount() const;
+
+    // Samples of one chunk; 'count' receives their number
+    const TrainingSample* chunk(std::size_t i, std::size_t& count) const;
+};
+
+#endif
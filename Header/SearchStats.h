@@ -0,0 +1,48 @@
+// SearchStats.h
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Maximum number of moves in any position (one per board cell)
+constexpr int MAX_MOVES = 9;
+
+// Raw counters bumped inside the search loop.
+// Aligned to a full cache line so that one block per search thread never
+// shares a line with another thread's block (no false sharing).
+struct alignas(64) SearchCounters {
+    std::uint64_t nodes = 0;                  // Positions visited (interior + leaves)
+    std::uint64_t leafEvaluations = 0;        // Terminal / horizon positions scored
+    std::uint64_t ttProbes = 0;               // Transposition table lookups
+    std::uint64_t ttHits = 0;                 // Lookups that returned a usable entry
+    std::uint64_t threatNodes = 0;            // Positions visited by the threat-space pre-pass
+    std::array<std::uint64_t, MAX_MOVES> cutoffsByMoveIndex{}; // Beta cutoffs, by index of the refuting move
+    int depthReached = 0;                     // Deepest ply visited
+
+    void reset();                             // Zero every counter
+    void merge(const SearchCounters& other);  // Add another thread's counters into this one
+};
+
+// Summary of one findBestMove call, suitable for logging and for tests
+struct SearchStats {
+    SearchCounters counters;                            // Aggregated counters of all search threads
+    std::chrono::microseconds elapsed{0};               // Wall-clock time of the whole call
+    std::vector<std::pair<int, int>> principalVariation; // Expected line of play, starting with the chosen move
+    bool fromBook = false;                              // Move came from the opening book, no search ran
+    bool fromThreatSearch = false;                      // Move starts a forced win found by threat-space search
+    bool fromTablebase = false;                         // Move came from the solved-position tablebase
+    bool scored = false;                                // 'score' is known: a search or a found win chose the move
+    int score = 0;                                      // Value of the chosen move for the side to move, noise excluded
+
+    std::uint64_t totalCutoffs() const;       // Sum of cutoffsByMoveIndex
+    double nodesPerSecond() const;            // nodes / elapsed, 0 when nothing was timed
+    double ttHitRate() const;                 // ttHits / ttProbes, 0 without probes
+    std::string toString() const;             // One-line summary for logs
+};
+
+#endif
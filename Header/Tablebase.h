@@ -0,0 +1,53 @@
+// Tablebase.h
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "Game.h"
+#include "MappedFile.h"
+#include "ProofSolver.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Exact value of every legal position, precomputed by retrograde analysis.
+//
+// Only canonical (symmetry-reduced) positions are stored. A position's base-3
+// code (cell value 0 = empty, 1 = X, 2 = O) is a combinatorial index into a
+// bitmap of canonical positions; the rank of its bit, from a per-word rank
+// directory plus a popcount, is a minimal perfect hash into one value byte
+// per position. Each byte packs the outcome (2 bits) and the distance to the
+// end of the game in plies (4 bits). The whole file is under one 4 KiB page.
+class Tablebase {
+private:
+    MappedFile file;
+    const std::uint64_t* bitmap;        // One bit per base-3 code, set for stored positions
+    const std::uint16_t* ranks;         // Set bits before each bitmap word
+    const std::uint8_t* values;         // Packed values in code order
+    std::size_t positionCount;
+
+    // Packed value of the position, false if it is not a legal position
+    bool lookup(const Game& game, std::uint8_t& value) const;
+
+public:
+    Tablebase();
+
+    bool open(const std::string& path);     // False if missing or not a valid tablebase
+    void close();
+    bool isOpen() const;
+    std::size_t size() const;               // Number of stored positions
+
+    // Value for the side to move and plies until the game ends with best play
+    // (wins as fast, losses as slow as possible)
+    bool probe(const Game& game, ProofResult& result, int& distance) const;
+
+    // Best move with no search: the child that is worst for the opponent
+    bool bestMove(const Game& game, std::pair<int, int>& move) const;
+
+    // Solves every legal position, one layer of equal mark count at a time
+    // from the full board down; the positions of a layer are split over
+    // 'threads' workers (0 = one per hardware thread). False on write errors.
+    static bool generate(const std::string& path, unsigned int threads = 0);
+};
+
+#endif
@@ -0,0 +1,44 @@
+// ThreadPool.h
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads running submitted tasks in FIFO order.
+// Workers are started once and reused, so bulk callers don't pay for
+// thread creation on every call.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;   // Signals workers: new task or shutdown
+    std::condition_variable allDone;     // Signals wait(): queue drained
+    std::size_t running;                 // Tasks currently executing
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    // 0 threads = one per hardware thread
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();                       // Finishes queued tasks, then joins
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();                         // Blocks until every submitted task has finished
+    std::size_t threadCount() const;
+
+    // Pool shared by the whole process, created on first use
+    static ThreadPool& shared();
+};
+
+#endif
@@ -0,0 +1,34 @@
+// ThreatSearch.h
+#ifndef THREATSEARCH_H
+#define THREATSEARCH_H
+
+#include "Game.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Threat-space search: looks for a forced win using only moves that create
+// a threat (two in a line with the third cell open). Every such move leaves
+// the opponent a single reply, so the tree stays narrow and deep forced
+// wins are found long before a full alpha-beta search would see them.
+class ThreatSearch {
+private:
+    int maxAttackerMoves;       // Depth limit, in moves of the attacking side
+    std::uint64_t nodeCount;    // Positions visited by the last call
+
+    bool search(std::uint16_t mine, std::uint16_t theirs, int movesLeft, std::vector<int>& line);
+
+public:
+    explicit ThreatSearch(int maxAttackerMoves = 4);
+
+    // True if the side to move can force a win; 'line' receives the forcing
+    // sequence (attacker move, forced reply, ...) ending with the winning move
+    bool findForcedWin(const Game& game, std::vector<std::pair<int, int>>& line);
+
+    std::uint64_t nodes() const;
+
+    // Empty cells that would complete a line of 'mine' (cell masks, bit = row * 3 + col)
+    static std::uint16_t winningCells(std::uint16_t mine, std::uint16_t theirs);
+};
+
+#endif
@@ -0,0 +1,89 @@
+// Tournament.h
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "AI.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// One engine configuration taking part in a match
+struct EngineConfig {
+    std::string name;
+    SearchLimits limits;
+};
+
+// Sequential probability ratio test on the Elo difference between two engines.
+// H0: difference is elo0, H1: difference is elo1; alpha / beta are the
+// false-positive / false-negative rates. The log-likelihood ratio uses the
+// normal approximation of the game scores (0, 1/2, 1).
+enum class SprtDecision { CONTINUE, ACCEPT_H0, ACCEPT_H1 };
+
+class Sprt {
+private:
+    double elo0;
+    double elo1;
+    double lower;   // log(beta / (1 - alpha))
+    double upper;   // log((1 - beta) / alpha)
+
+public:
+    Sprt(double elo0 = 0.0, double elo1 = 10.0, double alpha = 0.05, double beta = 0.05);
+
+    double llr(std::uint64_t wins, std::uint64_t draws, std::uint64_t losses) const;
+    SprtDecision decide(std::uint64_t wins, std::uint64_t draws, std::uint64_t losses) const;
+    double lowerBound() const;
+    double upperBound() const;
+
+    static double expectedScore(double elo);            // Logistic Elo model
+    static double eloFromScore(double score);           // Inverse, score clamped inside (0, 1)
+};
+
+// A match of engine A against engine B
+struct TournamentSettings {
+    EngineConfig engineA;
+    EngineConfig engineB;
+    std::uint64_t maxGames = 1000;   // Upper bound, rounded up to whole pairs
+    int randomPlies = 1;             // Random opening moves before the engines play
+    unsigned int threads = 0;        // 0 = one per hardware thread
+    unsigned int seed = 1;
+    Sprt sprt;
+};
+
+// One finished game, from engine A's point of view
+struct TournamentGame {
+    std::uint64_t index;
+    std::uint64_t opening;           // Both games of a pair share their opening
+    bool aPlaysX;
+    int result;                      // 1 = A won, 0 = draw, -1 = A lost
+    std::string moves;               // Cells played, e.g. "40812"
+};
+
+struct TournamentResult {
+    std::uint64_t wins = 0;          // Counted for engine A
+    std::uint64_t draws = 0;
+    std::uint64_t losses = 0;
+    double llr = 0.0;
+    SprtDecision decision = SprtDecision::CONTINUE;
+
+    std::uint64_t games() const;
+    double score() const;            // Average points of A per game
+    double elo() const;              // Estimated Elo difference A - B
+    double eloMargin() const;        // 95% confidence half-width
+};
+
+// Plays pairs of games (same random opening, colours swapped) on a thread
+// pool until the SPRT decides or maxGames is reached. 'onGame' is called for
+// every finished game, one call at a time.
+class Tournament {
+private:
+    TournamentSettings settings;
+
+public:
+    explicit Tournament(const TournamentSettings& settings);
+
+    TournamentResult run(const std::function<void(const TournamentGame&)>& onGame = nullptr);
+
+    static std::string decisionName(SprtDecision decision);
+};
+
+#endif
@@ -0,0 +1,79 @@
+// TranspositionTable.h
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// How a stored score relates to the true value of the position
+enum class Bound : std::uint8_t { NONE = 0, EXACT, LOWER, UPPER };
+
+// One cached search result, as read back by probe
+struct TTEntry {
+    std::uint32_t key = 0;        // Full position key, verifies the slot
+    std::int16_t score = 0;       // Score from the side to move's point of view
+    std::uint8_t depth = 0;       // Remaining depth the score was searched to
+    Bound bound = Bound::NONE;    // NONE marks an empty slot
+    std::uint8_t bestMove = 0xFF; // Cell index (row * 3 + col), 0xFF if none
+    std::uint8_t generation = 0;  // Search that last stored this entry
+};
+
+// Bounded cache of search results keyed by position, kept across searches.
+// Scores are side-to-move relative so one table serves both players.
+//
+// Slots are grouped in cache-line buckets. A store replaces the same
+// position if present, else the bucket's least valuable entry: shallow
+// results and results from older searches (generations) go first, so a
+// long session keeps what it keeps reaching without ever growing.
+//
+// Each entry is packed into one atomic 64-bit word, so searches on several
+// threads can probe and store into the same table: a reader sees an entry
+// whole or not at all, and two writers racing for a slot only lose one of
+// the results. Depths are kept up to 31 and generations modulo 32.
+class TranspositionTable {
+public:
+    static constexpr std::size_t BUCKET_SIZE = 8;
+
+private:
+    struct alignas(64) Bucket {
+        std::atomic<std::uint64_t> slots[BUCKET_SIZE];   // 0 = empty
+    };
+
+    Bucket* buckets;
+    std::size_t bucketCount;      // Power of two
+    std::size_t mask;             // bucketCount - 1
+    bool mapped;                  // Allocated with mmap instead of operator new
+    bool hugePages;               // Huge pages were requested
+    std::uint8_t generation;      // Changed only while no search is running
+
+    static std::uint64_t pack(const TTEntry& entry);
+    static TTEntry unpack(std::uint64_t slot);
+
+    Bucket& bucketOf(std::uint32_t key) const;
+    void allocate(std::size_t count, bool useHugePages);
+    void release();
+    void copySlots(const TranspositionTable& other);
+
+public:
+    explicit TranspositionTable(std::size_t entryCount = 1 << 14);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable& other);
+    TranspositionTable& operator=(const TranspositionTable& other);
+
+    // Reallocates (and empties) the table to use at most 'bytes' of memory.
+    // With useHugePages on Linux the memory is backed by huge pages when the
+    // system has some reserved, else by transparent huge pages if enabled.
+    void resize(std::size_t bytes, bool useHugePages = false);
+
+    bool probe(std::uint32_t key, TTEntry& out) const;       // True if key is stored
+    void store(std::uint32_t key, int score, int depth, Bound bound, int bestMove);
+    void newSearch();                                        // Ages every stored entry by one
+    void clear();                                            // Empties every slot
+    std::size_t size() const;                                // Number of slots
+    std::size_t memoryUsage() const;                         // Bytes allocated
+    std::size_t occupied() const;                            // Slots holding an entry
+};
+
+#endif
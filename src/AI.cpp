@@ -1,63 +1,507 @@
 #include "AI.h"
+#include "BoardKey.h"
+#include "Evaluator.h"
+#include "ThreadPool.h"
 #include <climits>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
 
-AI::AI(Player aiPlayer) : aiPlayer(aiPlayer) {}
+SearchLimits SearchLimits::forDifficulty(Difficulty difficulty) {
+    SearchLimits limits;
+    switch (difficulty) {
+    case Difficulty::EASY:
+        // Looks two plies ahead and plays loosely
+        limits.maxDepth = 2;
+        limits.maxNodes = 500;
+        limits.maxTime = std::chrono::milliseconds(20);
+        limits.rootNoise = 6;
+        break;
+    case Difficulty::MEDIUM:
+        // Sees short tactics, occasionally misjudges quiet moves
+        limits.maxDepth = 4;
+        limits.maxNodes = 5000;
+        limits.maxTime = std::chrono::milliseconds(100);
+        limits.rootNoise = 2;
+        break;
+    case Difficulty::HARD:
+        // Perfect play: full-depth search, no caps, no noise
+        break;
+    }
+    return limits;
+}
+
+AI::AI(Player aiPlayer, Difficulty difficulty)
+    : AI(aiPlayer, SearchLimits::forDifficulty(difficulty)) {}
+
+AI::AI(Player aiPlayer, const SearchLimits& limits)
+    : aiPlayer(aiPlayer), limits(limits), rng(std::random_device{}()),
+      searchDepth(limits.maxDepth), canAbort(false), stopSearch(false), openingBook(nullptr),
+      tablebase(nullptr), neuralEvaluator(nullptr), sharedTable(nullptr), pvLength{} {
+    // The board has 9 cells, deeper limits are meaningless
+    this->limits.maxDepth = std::max(1, std::min(this->limits.maxDepth, MAX_PLY - 2));
+
+    // N attacking moves span 2N - 1 plies; stay within the depth budget
+    threatSearch = ThreatSearch((this->limits.maxDepth + 1) / 2);
+}
+
+AI::AI(const AI& parent, TranspositionTable& shared)
+    : aiPlayer(parent.aiPlayer), limits(parent.limits), rng(parent.rng), searchDepth(parent.searchDepth),
+      canAbort(false), stopSearch(false), openingBook(parent.openingBook), tablebase(parent.tablebase),
+      neuralEvaluator(parent.neuralEvaluator), threatSearch(parent.threatSearch),
+      tt(1), sharedTable(&shared), pvLength{} {}  // Own table left at one bucket, never used
+
+TranspositionTable& AI::table() {
+    return sharedTable != nullptr ? *sharedTable : tt;
+}
+
+const TranspositionTable& AI::table() const {
+    return sharedTable != nullptr ? *sharedTable : tt;
+}
+
+void AI::setOpeningBook(const OpeningBook* book) {
+    openingBook = book;
+}
+
+void AI::setTablebase(const Tablebase* table) {
+    tablebase = table;
+}
+
+void AI::setNeuralEvaluator(const NeuralEvaluator* evaluator) {
+    // Cached scores came from the previous evaluator
+    if (evaluator != neuralEvaluator) {
+        tt.clear();
+    }
+    neuralEvaluator = evaluator;
+}
+
+void AI::setCacheSize(std::size_t bytes, bool hugePages) {
+    tt.resize(bytes, hugePages);
+}
+
+void AI::clearCache() {
+    tt.clear();
+}
+
+std::size_t AI::getCacheSize() const {
+    return tt.memoryUsage();
+}
+
+const SearchLimits& AI::getLimits() const {
+    return limits;
+}
+
+void AI::setRandomSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+std::string AI::difficultyName(Difficulty difficulty) {
+    switch (difficulty) {
+    case Difficulty::EASY: return "Easy";
+    case Difficulty::MEDIUM: return "Medium";
+    case Difficulty::HARD: return "Hard";
+    }
+    return "Unknown";
+}
+
+bool AI::budgetExhausted() {
+    if (stopSearch) return true;
+    if (!canAbort) return false;
+
+    if (limits.maxNodes != 0 && counters.nodes >= limits.maxNodes) {
+        stopSearch = true;
+    } else if (limits.maxTime.count() != 0 && (counters.nodes & 63) == 0 &&
+               std::chrono::steady_clock::now() - searchStart >= limits.maxTime) {
+        stopSearch = true; // Clock is only read every 64 nodes
+    }
+    return stopSearch;
+}
+
+const SearchStats& AI::getLastSearchStats() const {
+    return lastStats;
+}
+
+// Win / loss scores are stored relative to the node, so they stay correct
+// when the same position is reached at a different ply
+static int scoreToTable(int score, int ply, int winThreshold) {
+    if (score >= winThreshold) return score + ply;
+    if (score <= -winThreshold) return score - ply;
+    return score;
+}
+
+static int scoreFromTable(int score, int ply, int winThreshold) {
+    if (score >= winThreshold) return score - ply;
+    if (score <= -winThreshold) return score + ply;
+    return score;
+}
+
+void AI::updatePV(int ply, const std::pair<int, int>& move) {
+    pvTable[ply][ply] = move;
+    for (int i = ply + 1; i < pvLength[ply + 1]; ++i) {
+        pvTable[ply][i] = pvTable[ply + 1][i];
+    }
+    pvLength[ply] = std::max(pvLength[ply + 1], ply + 1);
+}
+
+void AI::extendPV(Game game, std::vector<std::pair<int, int>>& pv) const {
+    for (const auto& move : pv) {
+        game.makeMove(move.first, move.second);
+    }
+
+    TTEntry entry;
+    int symmetry = 0;
+    while (game.getWinner() == Player::NONE && !game.isDraw() &&
+           table().probe(BoardKey::canonical(BoardKey::fromGame(game), symmetry), entry) &&
+           entry.bestMove != 0xFF) {
+        int cell = BoardKey::transformCell(entry.bestMove, BoardKey::inverseSymmetry(symmetry));
+        int row = cell / 3;
+        int col = cell % 3;
+        if (!game.makeMove(row, col)) {
+            break;
+        }
+        pv.emplace_back(row, col);
+    }
+}
+
+int AI::negamax(const Game& game, int alpha, int beta, int ply) {
+    if (budgetExhausted()) {
+        return 0; // Result is discarded by the root
+    }
+
+    counters.nodes++;
+    counters.depthReached = std::max(counters.depthReached, ply);
+    pvLength[ply] = ply; // Empty line until a move raises alpha
 
-int AI::minimax(Game game, bool isMaximizing, int alpha, int beta, int depth) {
-    // Terminal states
-    Player winner = game.getWinner();
-    if (winner == aiPlayer) {
-        return 10 - depth; // Prefer quicker wins
-    } else if (winner != Player::NONE && winner != aiPlayer) {
-        return depth - 10; // Prefer later losses
+    // Terminal states: only the player who just moved can have won
+    if (game.getWinner() != Player::NONE) {
+        counters.leafEvaluations++;
+        return ply - WIN_SCORE; // Prefer quicker wins and later losses
     } else if (game.isDraw()) {
+        counters.leafEvaluations++;
         return 0; // Draw
     }
     
-    // Depth limit to prevent infinite recursion
-    if (depth > 9) {
-        return 0;
+    std::uint32_t key = BoardKey::fromGame(game);
+
+    // Horizon of the current iterative-deepening pass: static evaluation
+    if (ply >= searchDepth) {
+        counters.leafEvaluations++;
+        if (neuralEvaluator != nullptr) {
+            return neuralEvaluator->evaluate(accumulators[ply], game.getCurrentPlayer());
+        }
+        std::uint16_t xCells = static_cast<std::uint16_t>(key & 0x1FF);
+        std::uint16_t oCells = static_cast<std::uint16_t>(key >> 9);
+        return (game.getCurrentPlayer() == Player::X) ? Evaluator::evaluate(xCells, oCells)
+                                                      : Evaluator::evaluate(oCells, xCells);
+    }
+
+    const int winThreshold = WIN_SCORE - MAX_PLY;
+    int depth = searchDepth - ply;
+    int ttMove = -1;
+
+    // Rotated and mirrored copies share one entry; stored moves are in the
+    // canonical board's frame
+    int symmetry = 0;
+    std::uint32_t canonicalKey = BoardKey::canonical(key, symmetry);
+
+    TTEntry entry;
+    counters.ttProbes++;
+    if (table().probe(canonicalKey, entry)) {
+        if (entry.bestMove != 0xFF) {
+            ttMove = BoardKey::transformCell(entry.bestMove, BoardKey::inverseSymmetry(symmetry));
+        }
+        if (entry.depth >= depth) {
+            counters.ttHits++;
+            int score = scoreFromTable(entry.score, ply, winThreshold);
+            if (entry.bound == Bound::EXACT ||
+                (entry.bound == Bound::LOWER && score >= beta) ||
+                (entry.bound == Bound::UPPER && score <= alpha)) {
+                return score;
+            }
+        }
     }
     
     std::vector<std::pair<int, int>> availableMoves = game.getAvailableMoves();
-    
-    // Determine which player's turn it is
-    Player currentPlayer = game.getCurrentPlayer();
-    bool isAITurn = (currentPlayer == aiPlayer);
-    
-    if (isAITurn) {
-        // AI's turn - maximize
-        int maxEval = INT_MIN;
-        for (const auto& move : availableMoves) {
-            Game tempGame = game;
-            tempGame.makeMove(move.first, move.second);
-            int eval = minimax(tempGame, false, alpha, beta, depth + 1);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha) {
-                break; // Alpha-beta pruning
+
+    // Try the move that was best last time first
+    if (ttMove >= 0) {
+        for (size_t i = 1; i < availableMoves.size(); ++i) {
+            if (availableMoves[i].first * 3 + availableMoves[i].second == ttMove) {
+                std::rotate(availableMoves.begin(), availableMoves.begin() + i,
+                            availableMoves.begin() + i + 1);
+                break;
             }
         }
-        return maxEval;
-    } else {
-        // Opponent's turn - minimize
-        int minEval = INT_MAX;
+    }
+
+    int originalAlpha = alpha;
+    int bestScore = -WIN_SCORE - 1;
+    int bestMove = -1;
+
+    for (size_t i = 0; i < availableMoves.size(); ++i) {
+        const auto& move = availableMoves[i];
+        Game tempGame = game;
+        tempGame.makeMove(move.first, move.second);
+        pushAccumulator(game, move, ply);
+        int score = -negamax(tempGame, -beta, -alpha, ply + 1);
+        if (stopSearch) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move.first * 3 + move.second;
+        }
+        if (score > alpha) {
+            alpha = score;
+            updatePV(ply, move);
+        }
+        if (alpha >= beta) {
+            counters.cutoffsByMoveIndex[i]++;
+            break; // Alpha-beta pruning
+        }
+    }
+
+    Bound bound = (bestScore <= originalAlpha) ? Bound::UPPER
+                : (bestScore >= beta) ? Bound::LOWER
+                : Bound::EXACT;
+    table().store(canonicalKey, scoreToTable(bestScore, ply, winThreshold), depth, bound,
+                  bestMove < 0 ? -1 : BoardKey::transformCell(bestMove, symmetry));
+    return bestScore;
+}
+
+void AI::refreshAccumulator(const Game& game) {
+    if (neuralEvaluator != nullptr) {
+        std::uint32_t key = BoardKey::fromGame(game);
+        neuralEvaluator->refresh(accumulators[0], static_cast<std::uint16_t>(key & 0x1FF),
+                                 static_cast<std::uint16_t>(key >> 9));
+    }
+}
+
+void AI::pushAccumulator(const Game& game, const std::pair<int, int>& move, int ply) {
+    if (neuralEvaluator != nullptr) {
+        accumulators[ply + 1] = accumulators[ply];
+        neuralEvaluator->addMark(accumulators[ply + 1], game.getCurrentPlayer(), move.first * 3 + move.second);
+    }
+}
+
+void AI::beginSearch() {
+    table().newSearch();
+    beginMove();
+}
+
+void AI::beginMove() {
+    counters.reset();
+    lastStats = SearchStats();
+    searchStart = std::chrono::steady_clock::now();
+    canAbort = false;
+    stopSearch = false;
+}
+
+void AI::endSearch(std::chrono::steady_clock::time_point start) {
+    lastStats.counters = counters;
+    lastStats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+std::pair<int, int> AI::findBestMove(Game game) {
+    auto start = std::chrono::steady_clock::now();
+    beginSearch();
+
+    std::pair<int, int> bestMove = chooseMove(game);
+
+    endSearch(start);
+    if (lastStats.principalVariation.empty() && bestMove.first >= 0) {
+        lastStats.principalVariation.push_back(bestMove); // Forced / shortcut moves
+    }
+    return bestMove;
+}
+
+std::pair<int, int> AI::findBestMove(Game game, const GameClock& clock) {
+    if (!clock.getControl().isTimed()) {
+        return findBestMove(game);
+    }
+
+    std::chrono::milliseconds budget = TimeManager::moveBudget(
+        game, clock.remaining(game.getCurrentPlayer()), clock.getControl().increment);
+
+    // The level's limits come back however the search ends, exceptions included
+    struct LimitsGuard {
+        SearchLimits& limits;
+        SearchLimits saved;
+
+        ~LimitsGuard() {
+            limits = saved;
+        }
+    } restore{limits, limits};
+
+    if (limits.maxTime.count() == 0 || budget < limits.maxTime) {
+        limits.maxTime = budget;
+    }
+    return findBestMove(game);
+}
+
+std::vector<std::pair<int, int>> AI::findBestMoves(const std::vector<Game>& games,
+                                                   std::chrono::milliseconds deadline) {
+    auto start = std::chrono::steady_clock::now();
+    beginSearch();
+    std::vector<std::pair<int, int>> moves(games.size(), std::make_pair(-1, -1));
+
+    // Without noise a position always gets the same answer, so each distinct
+    // position (up to symmetry) is searched once and the move is mapped back
+    // onto its copies. 'searched' lists the games that are actually searched.
+    bool deterministic = limits.rootNoise == 0;
+    std::vector<std::size_t> representative(games.size());
+    std::vector<int> symmetry(games.size(), 0);
+    std::vector<std::size_t> searched;
+    std::unordered_map<std::uint32_t, std::size_t> firstWithKey;
+
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        representative[i] = i;
+        if (deterministic) {
+            std::uint32_t key = BoardKey::canonical(BoardKey::fromGame(games[i]), symmetry[i]);
+            auto inserted = firstWithKey.emplace(key, i);
+            representative[i] = inserted.first->second;
+            if (!inserted.second) {
+                continue;
+            }
+        }
+        searched.push_back(i);
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+    std::size_t workerCount = std::min(pool.threadCount(), searched.size());
+    std::vector<SearchCounters> workerCounters(workerCount);
+    std::atomic<std::size_t> nextGame{0};
+
+    // Completion of this call's workers only; other callers may share the pool
+    std::mutex doneMutex;
+    std::condition_variable workersDone;
+    std::size_t finishedWorkers = 0;
+
+    // Noisy levels stay reproducible under setRandomSeed
+    std::vector<unsigned int> seeds(workerCount);
+    for (auto& seed : seeds) {
+        seed = rng();
+    }
+
+    for (std::size_t w = 0; w < workerCount; ++w) {
+        pool.submit([&, w] {
+            // Each worker searches into this AI's table, aged once above
+            AI worker(*this, tt);
+            worker.rng.seed(seeds[w]);
+            worker.beginMove();
+
+            for (std::size_t next = nextGame++; next < searched.size(); next = nextGame++) {
+                const Game& game = games[searched[next]];
+                worker.aiPlayer = game.getCurrentPlayer();
+                worker.limits.maxTime = limits.maxTime;
+
+                if (deadline.count() != 0) {
+                    // Whatever is left of the call's budget, at least 1 ms so the
+                    // first iterative-deepening pass still produces a move
+                    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - (std::chrono::steady_clock::now() - start));
+                    left = std::max(left, std::chrono::milliseconds(1));
+                    if (worker.limits.maxTime.count() == 0 || left < worker.limits.maxTime) {
+                        worker.limits.maxTime = left;
+                    }
+                }
+
+                worker.beginMove();
+                moves[searched[next]] = worker.chooseMove(game);
+                workerCounters[w].merge(worker.counters);
+            }
+
+            std::lock_guard<std::mutex> lock(doneMutex);
+            finishedWorkers++;
+            workersDone.notify_one();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        workersDone.wait(lock, [&] { return finishedWorkers == workerCount; });
+    }
+
+    // Copies take the representative's move, mapped through both symmetries
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        std::size_t source = representative[i];
+        if (source == i || moves[source].first < 0) {
+            continue;
+        }
+        int cell = BoardKey::transformCell(moves[source].first * 3 + moves[source].second, symmetry[source]);
+        cell = BoardKey::transformCell(cell, BoardKey::inverseSymmetry(symmetry[i]));
+        moves[i] = std::make_pair(cell / 3, cell % 3);
+    }
+
+    for (const auto& workerCounter : workerCounters) {
+        counters.merge(workerCounter);
+    }
+    endSearch(start);
+    return moves;
+}
+
+std::vector<MoveAnalysis> AI::analyze(const Game& game) {
+    auto start = std::chrono::steady_clock::now();
+    beginSearch();
+
+    // One pass at the AI's depth, without node/time caps or noise, so every
+    // move gets a comparable score. Siblings share the table, so positions
+    // reachable from several root moves are only searched once.
+    searchDepth = limits.maxDepth;
+    std::vector<std::pair<int, int>> availableMoves = game.getAvailableMoves();
+    int emptyCells = static_cast<int>(availableMoves.size());
+    bool reachesEnd = searchDepth >= emptyCells;
+    const int winThreshold = WIN_SCORE - MAX_PLY;
+
+    std::vector<MoveAnalysis> results;
+    int bestScore = -WIN_SCORE - 1;
+
+    if (game.getWinner() == Player::NONE) {
+        refreshAccumulator(game);
         for (const auto& move : availableMoves) {
             Game tempGame = game;
             tempGame.makeMove(move.first, move.second);
-            int eval = minimax(tempGame, true, alpha, beta, depth + 1);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-            if (beta <= alpha) {
-                break; // Alpha-beta pruning
+            pushAccumulator(game, move, 0);
+
+            // Full window: each move needs its exact value, not just a bound
+            int score = -negamax(tempGame, -WIN_SCORE - 1, WIN_SCORE + 1, 1);
+
+            MoveAnalysis analysis{move, score, MoveOutcome::HEURISTIC, 0};
+            if (score >= winThreshold) {
+                analysis.outcome = MoveOutcome::WIN;
+                analysis.distance = WIN_SCORE - score;
+            } else if (score <= -winThreshold) {
+                analysis.outcome = MoveOutcome::LOSS;
+                analysis.distance = WIN_SCORE + score;
+            } else if (reachesEnd) {
+                analysis.outcome = MoveOutcome::DRAW;
+                analysis.distance = emptyCells;
+            }
+            results.push_back(analysis);
+
+            if (score > bestScore) {
+                bestScore = score;
+                lastStats.principalVariation.assign(1, move);
+                lastStats.principalVariation.insert(lastStats.principalVariation.end(),
+                                                    pvTable[1] + 1, pvTable[1] + pvLength[1]);
             }
         }
-        return minEval;
     }
+
+    std::stable_sort(results.begin(), results.end(),
+                     [](const MoveAnalysis& a, const MoveAnalysis& b) { return a.score > b.score; });
+
+    extendPV(game, lastStats.principalVariation);
+    endSearch(start);
+    return results;
 }
 
-std::pair<int, int> AI::findBestMove(Game game) {
+std::pair<int, int> AI::chooseMove(const Game& game) {
     std::vector<std::pair<int, int>> availableMoves = game.getAvailableMoves();
     
     // If no moves available, return invalid move
@@ -69,12 +513,28 @@ std::pair<int, int> AI::findBestMove(Game game) {
     if (availableMoves.size() == 1) {
         return availableMoves[0];
     }
+
+    // Solved positions need no search at all
+    std::pair<int, int> tablebaseMove;
+    if (tablebase != nullptr && tablebase->bestMove(game, tablebaseMove)) {
+        lastStats.fromTablebase = true;
+        return tablebaseMove;
+    }
+
+    // Known opening positions are answered from the book without searching
+    std::pair<int, int> bookMove;
+    if (openingBook != nullptr && openingBook->probe(game, bookMove)) {
+        lastStats.fromBook = true;
+        return bookMove;
+    }
     
     // First, check for immediate winning moves
     for (const auto& move : availableMoves) {
         Game tempGame = game;
         tempGame.makeMove(move.first, move.second);
         if (tempGame.getWinner() == aiPlayer) {
+            lastStats.scored = true;
+            lastStats.score = WIN_SCORE - 1;
             return move; // Take the winning move immediately
         }
     }
@@ -89,23 +549,79 @@ std::pair<int, int> AI::findBestMove(Game game) {
         }
     }
     
-    // If no immediate win/block, use minimax
+    // Third, look for a win forced by threats alone (cheap, narrow search)
+    std::vector<std::pair<int, int>> forcedLine;
+    bool forced = threatSearch.findForcedWin(game, forcedLine);
+    counters.threatNodes += threatSearch.nodes();
+    if (forced) {
+        lastStats.fromThreatSearch = true;
+        lastStats.principalVariation = forcedLine;
+        lastStats.scored = true;
+        lastStats.score = WIN_SCORE - static_cast<int>(forcedLine.size());
+        return forcedLine[0];
+    }
+    
+    // If no immediate win/block, use negamax.
+    // With a node or time cap, deepen one ply at a time and keep the result of
+    // the last pass that finished; without caps go straight to full depth.
     std::pair<int, int> bestMove = availableMoves[0];
-    int bestValue = INT_MIN;
+    int bestScore = 0;
+    bool capped = limits.maxNodes != 0 || limits.maxTime.count() != 0;
+    std::uniform_int_distribution<int> noise(-limits.rootNoise, limits.rootNoise);
+    refreshAccumulator(game);
     
-    for (const auto& move : availableMoves) {
-        Game tempGame = game;
-        tempGame.makeMove(move.first, move.second);
+    for (searchDepth = capped ? 1 : limits.maxDepth; searchDepth <= limits.maxDepth; ++searchDepth) {
+        std::pair<int, int> passBest = availableMoves[0];
+        int bestValue = INT_MIN;
+        int passScore = 0;             // bestValue without the noise
+        int alpha = -WIN_SCORE - 1;
+        std::vector<std::pair<int, int>> passPV;
         
-        // After AI makes the move, it's opponent's turn
-        int moveValue = minimax(tempGame, false, INT_MIN, INT_MAX, 0);
+        for (const auto& move : availableMoves) {
+            Game tempGame = game;
+            tempGame.makeMove(move.first, move.second);
+            pushAccumulator(game, move, 0);
+            
+            // After AI makes the move, it's opponent's turn. Noisy levels need
+            // every root score exactly, otherwise only better moves matter.
+            int beta = (limits.rootNoise > 0) ? WIN_SCORE + 1 : -alpha;
+            int moveValue = -negamax(tempGame, -WIN_SCORE - 1, beta, 1);
+            if (stopSearch) {
+                break;
+            }
+            int score = moveValue;
+            if (limits.rootNoise > 0) {
+                moveValue += noise(rng);
+            }
+            
+            if (moveValue > bestValue) {
+                bestValue = moveValue;
+                passScore = score;
+                passBest = move;
+                alpha = std::max(alpha, moveValue);
+
+                // Root move followed by the reply line found below it
+                passPV.assign(1, move);
+                passPV.insert(passPV.end(), pvTable[1] + 1, pvTable[1] + pvLength[1]);
+            }
+        }
         
-        if (moveValue > bestValue) {
-            bestValue = moveValue;
-            bestMove = move;
+        if (stopSearch) {
+            break; // Budget ran out mid-pass, keep the previous pass
         }
+        bestMove = passBest;
+        bestScore = passScore;
+        lastStats.principalVariation = passPV;
+        canAbort = true;
+
+        // Search the best move first in the next pass
+        std::iter_swap(availableMoves.begin(),
+                       std::find(availableMoves.begin(), availableMoves.end(), bestMove));
     }
     
+    extendPV(game, lastStats.principalVariation);
+    lastStats.scored = canAbort;  // At least one pass finished
+    lastStats.score = bestScore;
     return bestMove;
 }
 
@@ -158,85 +674,3 @@ bool AI::wouldOpponentWin(const Game& game, int row, int col, Player opponent) {
     
     return false;
 }
-
-// Strategic evaluation for early game optimization
-int AI::evaluatePosition(const Game& game) {
-    int score = 0;
-    
-    // Center position is valuable
-    if (game.at(1, 1) == aiPlayer) {
-        score += 3;
-    } else if (game.at(1, 1) != Player::NONE) {
-        score -= 3;
-    }
-    
-    // Corners are valuable
-    std::vector<std::pair<int, int>> corners = {{0,0}, {0,2}, {2,0}, {2,2}};
-    for (const auto& corner : corners) {
-        if (game.at(corner.first, corner.second) == aiPlayer) {
-            score += 2;
-        } else if (game.at(corner.first, corner.second) != Player::NONE) {
-            score -= 2;
-        }
-    }
-    
-    // Check for potential wins/blocks
-    score += evaluateLines(game);
-    
-    return score;
-}
-
-int AI::evaluateLines(const Game& game) {
-    int score = 0;
-    
-    // Check all possible lines (rows, columns, diagonals)
-    std::vector<std::vector<std::pair<int, int>>> lines = {
-        // Rows
-        {{0,0}, {0,1}, {0,2}},
-        {{1,0}, {1,1}, {1,2}},
-        {{2,0}, {2,1}, {2,2}},
-        // Columns
-        {{0,0}, {1,0}, {2,0}},
-        {{0,1}, {1,1}, {2,1}},
-        {{0,2}, {1,2}, {2,2}},
-        // Diagonals
-        {{0,0}, {1,1}, {2,2}},
-        {{0,2}, {1,1}, {2,0}}
-    };
-    
-    for (const auto& line : lines) {
-        int aiCount = 0;
-        int opponentCount = 0;
-        int emptyCount = 0;
-        
-        for (const auto& pos : line) {
-            Player cell = game.at(pos.first, pos.second);
-            if (cell == aiPlayer) {
-                aiCount++;
-            } else if (cell != Player::NONE) {
-                opponentCount++;
-            } else {
-                emptyCount++;
-            }
-        }
-        
-        // Scoring based on line evaluation
-        if (aiCount == 3) {
-            score += 100; // Win
-        } else if (aiCount == 2 && emptyCount == 1) {
-            score += 10; // Two in a row
-        } else if (aiCount == 1 && emptyCount == 2) {
-            score += 1; // One in a row
-        }
-        
-        if (opponentCount == 3) {
-            score -= 100; // Opponent win
-        } else if (opponentCount == 2 && emptyCount == 1) {
-            score -= 10; // Block opponent
-        } else if (opponentCount == 1 && emptyCount == 2) {
-            score -= 1; // Opponent has one
-        }
-    }
-    
-    return score;
-}
\ No newline at end of file
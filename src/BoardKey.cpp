@@ -0,0 +1,102 @@
+// BoardKey.cpp
+#include "BoardKey.h"
+#include <array>
+#include <bitset>    // For popcount
+
+namespace {
+    // CELL_MAP[s][cell] = image of cell under symmetry s
+    constexpr int CELL_MAP[BoardKey::SYMMETRY_COUNT][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8},   // Identity
+        {2, 5, 8, 1, 4, 7, 0, 3, 6},   // Rotate 90 degrees
+        {8, 7, 6, 5, 4, 3, 2, 1, 0},   // Rotate 180 degrees
+        {6, 3, 0, 7, 4, 1, 8, 5, 2},   // Rotate 270 degrees
+        {2, 1, 0, 5, 4, 3, 8, 7, 6},   // Mirror left-right
+        {6, 7, 8, 3, 4, 5, 0, 1, 2},   // Mirror top-bottom
+        {0, 3, 6, 1, 4, 7, 2, 5, 8},   // Transpose (main diagonal)
+        {8, 5, 2, 7, 4, 1, 6, 3, 0}    // Anti-transpose
+    };
+
+    // Rotations by 90 and 270 undo each other, every other symmetry is its own inverse
+    constexpr int INVERSE[BoardKey::SYMMETRY_COUNT] = {0, 3, 2, 1, 4, 5, 6, 7};
+
+    // MASK_MAP[s][cells] = image of a 9-bit cell mask under symmetry s, so a
+    // key transforms with two lookups (canonical() runs at every search node)
+    using MaskMap = std::array<std::array<std::uint16_t, 512>, BoardKey::SYMMETRY_COUNT>;
+
+    constexpr MaskMap buildMaskMap() {
+        MaskMap map{};
+        for (int s = 0; s < BoardKey::SYMMETRY_COUNT; ++s) {
+            for (int cells = 0; cells < 512; ++cells) {
+                std::uint16_t image = 0;
+                for (int cell = 0; cell < 9; ++cell) {
+                    if (cells & (1 << cell)) image |= static_cast<std::uint16_t>(1 << CELL_MAP[s][cell]);
+                }
+                map[s][cells] = image;
+            }
+        }
+        return map;
+    }
+
+    constexpr MaskMap MASK_MAP = buildMaskMap();
+}
+
+std::uint32_t BoardKey::fromGame(const Game& game) {
+    std::uint32_t key = 0;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            Player p = game.at(r, c);
+            if (p == Player::X) key |= 1u << (r * 3 + c);
+            else if (p == Player::O) key |= 1u << (r * 3 + c + 9);
+        }
+    }
+    return key;
+}
+
+Game BoardKey::toGame(std::uint32_t key) {
+    Game game;
+    int xCell = 0;
+    int oCell = 0;
+
+    // Alternate X and O placements; any order gives the same board
+    while (true) {
+        while (xCell < 9 && !(key & (1u << xCell))) xCell++;
+        if (xCell >= 9) break;
+        game.makeMove(xCell / 3, xCell % 3);
+        xCell++;
+
+        while (oCell < 9 && !(key & (1u << (oCell + 9)))) oCell++;
+        if (oCell >= 9) break;
+        game.makeMove(oCell / 3, oCell % 3);
+        oCell++;
+    }
+    return game;
+}
+
+int BoardKey::transformCell(int cell, int symmetry) {
+    return CELL_MAP[symmetry][cell];
+}
+
+int BoardKey::inverseSymmetry(int symmetry) {
+    return INVERSE[symmetry];
+}
+
+std::uint32_t BoardKey::transform(std::uint32_t key, int symmetry) {
+    return MASK_MAP[symmetry][key & 0x1FF] | (static_cast<std::uint32_t>(MASK_MAP[symmetry][(key >> 9) & 0x1FF]) << 9);
+}
+
+std::uint32_t BoardKey::canonical(std::uint32_t key, int& symmetry) {
+    std::uint32_t best = key;
+    symmetry = 0;
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        std::uint32_t candidate = transform(key, s);
+        if (candidate < best) {
+            best = candidate;
+            symmetry = s;
+        }
+    }
+    return best;
+}
+
+int BoardKey::countCells(std::uint32_t cells) {
+    return static_cast<int>(std::bitset<32>(cells).count());
+}
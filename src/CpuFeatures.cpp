@@ -0,0 +1,53 @@
+// CpuFeatures.cpp
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && defined(CPU_FEATURES_X86)
+#include <intrin.h>
+#endif
+
+namespace {
+    struct Features {
+        bool ssse3 = false;
+        bool sse42 = false;
+        bool avx2 = false;
+
+        Features() {
+#if defined(_MSC_VER) && defined(CPU_FEATURES_X86)
+            int info[4];
+            __cpuid(info, 0);
+            int maxLeaf = info[0];
+            __cpuid(info, 1);
+            ssse3 = (info[2] & (1 << 9)) != 0;
+            sse42 = (info[2] & (1 << 20)) != 0;
+            // AVX state must be enabled by the OS (OSXSAVE, then XMM and YMM in XCR0)
+            bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+            if (maxLeaf >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = osAvx && (info[1] & (1 << 5));
+            }
+#elif defined(CPU_FEATURES_X86)
+            __builtin_cpu_init(); // Safe even before other static constructors ran
+            ssse3 = __builtin_cpu_supports("ssse3");
+            sse42 = __builtin_cpu_supports("sse4.2");
+            avx2 = __builtin_cpu_supports("avx2");
+#endif
+        }
+    };
+
+    const Features& features() {
+        static const Features detected;
+        return detected;
+    }
+}
+
+bool CpuFeatures::hasSsse3() {
+    return features().ssse3;
+}
+
+bool CpuFeatures::hasSse42() {
+    return features().sse42;
+}
+
+bool CpuFeatures::hasAvx2() {
+    return features().avx2;
+}
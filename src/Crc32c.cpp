@@ -0,0 +1,95 @@
+// Crc32c.cpp
+#include "Crc32c.h"
+#include "CpuFeatures.h"
+#include <cstring>     // For memcpy
+
+#if defined(CPU_FEATURES_X86)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace {
+    // Reflected polynomial 0x1EDC6F41
+    const std::uint32_t POLYNOMIAL = 0x82F63B78u;
+
+    struct Table {
+        std::uint32_t entries[256];
+
+        Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+
+#if defined(CPU_FEATURES_X86) || defined(__ARM_FEATURE_CRC32)
+
+    // x86 needs SSE4.2, checked by the caller; ARM builds have the
+    // instructions whenever __ARM_FEATURE_CRC32 is set
+#if defined(CPU_FEATURES_X86)
+#define CRC_TARGET CPU_TARGET("sse4.2")
+#else
+#define CRC_TARGET
+#endif
+
+    CRC_TARGET std::uint32_t extendHardware(std::uint32_t crc, const unsigned char* bytes, std::size_t size) {
+        crc = ~crc;
+        for (; size >= 8; bytes += 8, size -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));  // Little-endian on both targets
+#if defined(__x86_64__) || defined(_M_X64)
+            crc = static_cast<std::uint32_t>(_mm_crc32_u64(crc, word));
+#elif defined(CPU_FEATURES_X86)
+            crc = _mm_crc32_u32(crc, static_cast<std::uint32_t>(word));
+            crc = _mm_crc32_u32(crc, static_cast<std::uint32_t>(word >> 32));
+#else
+            crc = __crc32cd(crc, word);
+#endif
+        }
+        for (; size > 0; ++bytes, --size) {
+#if defined(CPU_FEATURES_X86)
+            crc = _mm_crc32_u8(crc, *bytes);
+#else
+            crc = __crc32cb(crc, *bytes);
+#endif
+        }
+        return ~crc;
+    }
+
+#undef CRC_TARGET
+#endif
+}
+
+std::uint32_t Crc32c::extend(std::uint32_t crc, const void* data, std::size_t size) {
+#if defined(CPU_FEATURES_X86) || defined(__ARM_FEATURE_CRC32)
+    if (usesHardware()) {
+        return extendHardware(crc, static_cast<const unsigned char*>(data), size);
+    }
+#endif
+    return extendSoftware(crc, data, size);
+}
+
+std::uint32_t Crc32c::extendSoftware(std::uint32_t crc, const void* data, std::size_t size) {
+    static const Table table;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool Crc32c::usesHardware() {
+#if defined(CPU_FEATURES_X86)
+    return CpuFeatures::hasSse42();
+#elif defined(__ARM_FEATURE_CRC32)
+    return true;
+#else
+    return false;
+#endif
+}
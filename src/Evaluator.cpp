@@ -0,0 +1,100 @@
+// Evaluator.cpp
+#include "Evaluator.h"
+#include "BoardKey.h"
+#include "CpuFeatures.h"
+
+#if defined(CPU_FEATURES_X86)
+#include <tmmintrin.h>
+#endif
+
+namespace {
+    // The 8 winning lines as cell masks: rows, columns, diagonals
+    const std::uint16_t LINES[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+
+    // LINE_SCORE[own * 4 + opponent]: value of a line holding that many marks.
+    // Lines shared by both players are dead and score nothing.
+    const std::int8_t LINE_SCORE[16] = {
+        //  opp: 0     1     2     3
+                 0,   -1,  -10, -100,   // own 0
+                 1,    0,    0,    0,   // own 1
+                10,    0,    0,    0,   // own 2 (two in a row, third open)
+               100,    0,    0,    0    // own 3 (complete line)
+    };
+
+    const std::uint16_t CENTER = 0x010;   // (1,1)
+    const std::uint16_t CORNERS = 0x145;  // (0,0), (0,2), (2,0), (2,2)
+
+    // Center and corners take part in the most lines
+    int placementScore(std::uint16_t mine, std::uint16_t theirs) {
+        return 3 * (BoardKey::countCells(mine & CENTER) - BoardKey::countCells(theirs & CENTER)) +
+               2 * (BoardKey::countCells(mine & CORNERS) - BoardKey::countCells(theirs & CORNERS));
+    }
+}
+
+int Evaluator::evaluateScalar(std::uint16_t mine, std::uint16_t theirs) {
+    int score = placementScore(mine, theirs);
+    for (std::uint16_t line : LINES) {
+        int own = BoardKey::countCells(mine & line);
+        int opponent = BoardKey::countCells(theirs & line);
+        score += LINE_SCORE[own * 4 + opponent];
+    }
+    return score;
+}
+
+#if defined(CPU_FEATURES_X86)
+
+namespace {
+    // SSSE3 kernels, called only when the CPU has it
+
+    // Per 16-bit lane popcount: nibble lookup with a byte shuffle, then add the two bytes
+    CPU_TARGET("ssse3") __m128i popcount16(__m128i value) {
+        const __m128i nibbleCounts = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m128i lowNibble = _mm_set1_epi8(0x0F);
+        __m128i low = _mm_and_si128(value, lowNibble);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), lowNibble);
+        __m128i bytes = _mm_add_epi8(_mm_shuffle_epi8(nibbleCounts, low),
+                                     _mm_shuffle_epi8(nibbleCounts, high));
+        return _mm_add_epi16(_mm_and_si128(bytes, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(bytes, 8));
+    }
+
+    // Sum of LINE_SCORE over the 8 lines
+    CPU_TARGET("ssse3") int lineScoresSsse3(std::uint16_t mine, std::uint16_t theirs) {
+        const __m128i lines = _mm_setr_epi16(0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054);
+        const __m128i scoreTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(LINE_SCORE));
+
+        // Marks per line for both sides, all 8 lines at once
+        __m128i own = popcount16(_mm_and_si128(_mm_set1_epi16(static_cast<short>(mine)), lines));
+        __m128i opponent = popcount16(_mm_and_si128(_mm_set1_epi16(static_cast<short>(theirs)), lines));
+
+        // Table index own * 4 + opponent, packed to bytes, then a 16-entry byte lookup
+        __m128i index = _mm_add_epi16(_mm_slli_epi16(own, 2), opponent);
+        __m128i scores = _mm_shuffle_epi8(scoreTable, _mm_packus_epi16(index, _mm_setzero_si128()));
+
+        // Sign-extend the 8 byte scores to 16 bits and sum them
+        __m128i sign = _mm_cmpgt_epi8(_mm_setzero_si128(), scores);
+        __m128i wide = _mm_madd_epi16(_mm_unpacklo_epi8(scores, sign), _mm_set1_epi16(1));
+        wide = _mm_add_epi32(wide, _mm_shuffle_epi32(wide, _MM_SHUFFLE(1, 0, 3, 2)));
+        wide = _mm_add_epi32(wide, _mm_shuffle_epi32(wide, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        return _mm_cvtsi128_si32(wide);
+    }
+}
+
+#endif
+
+int Evaluator::evaluate(std::uint16_t mine, std::uint16_t theirs) {
+#if defined(CPU_FEATURES_X86)
+    if (usesSimd()) {
+        return lineScoresSsse3(mine, theirs) + placementScore(mine, theirs);
+    }
+#endif
+    return evaluateScalar(mine, theirs);
+}
+
+bool Evaluator::usesSimd() {
+#if defined(CPU_FEATURES_X86)
+    return CpuFeatures::hasSsse3();
+#else
+    return false;
+#endif
+}
@@ -18,11 +18,15 @@ void Game::reset() {
 
     // No moves played yet
     moveCount = 0;
+
+    // Nobody has run out of time
+    flagged = Player::NONE;
 }
 
 // Attempts to place the current player's move at (row, col)
-// Returns false if the cell is already taken
+// Returns false if the cell is already taken or a player lost on time
 bool Game::makeMove(int row, int col) {
+    if (flagged != Player::NONE) return false;         // Game already over
     if (board[row][col] != Player::NONE) return false; // Invalid move (cell taken)
 
     board[row][col] = currentPlayer;                   // Mark the cell
@@ -63,9 +67,23 @@ Player Game::getWinner() const {
     for (auto p : { Player::X, Player::O }) {
         if (isWin(p)) return p;
     }
+    if (flagged != Player::NONE) {
+        return (flagged == Player::X) ? Player::O : Player::X; // Won on time
+    }
     return Player::NONE;
 }
 
+// Records that 'side' ran out of time; ignored once the game is over
+void Game::flagFall(Player side) {
+    if (side == Player::NONE || getWinner() != Player::NONE || isDraw()) return;
+    flagged = side;
+}
+
+// Returns the player who lost on time, or Player::NONE
+Player Game::getFlagged() const {
+    return flagged;
+}
+
 // Returns a list of all empty positions on the board
 std::vector<std::pair<int, int>> Game::getAvailableMoves() const {
     std::vector<std::pair<int, int>> moves;
@@ -0,0 +1,131 @@
+// GameClock.cpp
+#include "GameClock.h"
+#include <algorithm>   // For std::min / std::max
+#include <cstdio>      // For snprintf
+
+using std::chrono::milliseconds;
+
+bool TimeControl::isTimed() const {
+    return base.count() > 0;
+}
+
+std::string TimeControl::toString() const {
+    if (!isTimed()) return "Untimed";
+
+    // Whole minutes read better as "1 min" than "60s"
+    auto part = [](milliseconds time) {
+        long long seconds = time.count() / 1000;
+        if (seconds >= 60 && seconds % 60 == 0) return std::to_string(seconds / 60) + " min";
+        return std::to_string(seconds) + "s";
+    };
+    std::string text = part(base);
+    if (increment.count() > 0) {
+        text += " + " + part(increment);
+    }
+    return text;
+}
+
+std::vector<TimeControl> TimeControl::presets() {
+    return {
+        TimeControl(),
+        TimeControl{milliseconds(5000), milliseconds(500)},
+        TimeControl{milliseconds(10000), milliseconds(1000)},
+        TimeControl{milliseconds(30000), milliseconds(2000)},
+        TimeControl{milliseconds(60000), milliseconds(0)},
+    };
+}
+
+GameClock::GameClock(const TimeControl& control)
+    : control(control), left{control.base, control.base}, side(Player::NONE) {}
+
+int GameClock::index(Player side) {
+    return side == Player::O ? 1 : 0;
+}
+
+void GameClock::start(Player side, Clock::time_point now) {
+    if (!control.isTimed()) return;
+    this->side = side;
+    turnStart = now;
+}
+
+bool GameClock::press(Clock::time_point now) {
+    if (side == Player::NONE) return true;
+
+    // Charge the mover; the increment is only earned by moving in time
+    milliseconds& mover = left[index(side)];
+    mover -= std::chrono::duration_cast<milliseconds>(now - turnStart);
+    bool inTime = mover.count() > 0;
+    if (inTime) {
+        mover += control.increment;
+    }
+
+    side = (side == Player::X) ? Player::O : Player::X;
+    turnStart = now;
+    return inTime;
+}
+
+void GameClock::stop(Clock::time_point now) {
+    if (side == Player::NONE) return;
+    left[index(side)] -= std::chrono::duration_cast<milliseconds>(now - turnStart);
+    side = Player::NONE;
+}
+
+milliseconds GameClock::remaining(Player side, Clock::time_point now) const {
+    milliseconds time = left[index(side)];
+    if (side == this->side) {
+        time -= std::chrono::duration_cast<milliseconds>(now - turnStart);
+    }
+    return std::max(time, milliseconds(0));
+}
+
+Player GameClock::flagged(Clock::time_point now) const {
+    if (!control.isTimed()) return Player::NONE;
+    for (Player p : {Player::X, Player::O}) {
+        if (remaining(p, now).count() == 0) return p;
+    }
+    return Player::NONE;
+}
+
+Player GameClock::running() const {
+    return side;
+}
+
+const TimeControl& GameClock::getControl() const {
+    return control;
+}
+
+std::string GameClock::format(milliseconds time) {
+    long long ms = std::max(time, milliseconds(0)).count();
+    char text[32];
+    if (ms < 10000) {
+        std::snprintf(text, sizeof(text), "0:%02lld.%lld", ms / 1000, (ms / 100) % 10);
+    } else {
+        long long seconds = ms / 1000;
+        std::snprintf(text, sizeof(text), "%lld:%02lld", seconds / 60, seconds % 60);
+    }
+    return text;
+}
+
+namespace TimeManager {
+
+// Time kept back for the UI and move latency, at most a tenth of the clock
+static constexpr milliseconds MOVE_OVERHEAD{50};
+
+milliseconds moveBudget(const Game& game, milliseconds remaining, milliseconds increment) {
+    if (remaining.count() <= 0) return milliseconds(1);
+
+    // Moves the side to move still has to make (it moves first in the rest)
+    int emptyCells = static_cast<int>(game.getAvailableMoves().size());
+    int movesToGo = std::max(1, (emptyCells + 1) / 2);
+
+    milliseconds usable = remaining - std::min(MOVE_OVERHEAD, remaining / 10);
+
+    // Even share of the time left, plus most of the increment earned back
+    milliseconds budget = usable / movesToGo + increment * 3 / 4;
+
+    // No single move may risk the rest of the game
+    milliseconds cap = movesToGo > 1 ? usable / 2 : usable;
+    return std::max(milliseconds(1), std::min(budget, cap));
+}
+
+}
@@ -7,7 +7,7 @@ GameModeWindow::GameModeWindow(const QString& username, QWidget *parent)
     : QWidget(parent), currentUsername(username)
 {
     setWindowTitle("Tic Tac Toe - Choose Game Mode");
-    setFixedSize(450, 550);
+    setFixedSize(450, 620);
     setupUI();
     applyStyles();
 }
@@ -41,6 +41,23 @@ void GameModeWindow::setupUI()
     aiButton->setObjectName("gameModeButton");
     aiButton->setFixedHeight(80);
 
+    // AI strength (index order matches the Difficulty enum)
+    difficultyBox = new QComboBox();
+    difficultyBox->setObjectName("difficultyBox");
+    difficultyBox->setFixedHeight(40);
+    for (Difficulty level : {Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD}) {
+        difficultyBox->addItem("AI difficulty: " + QString::fromStdString(AI::difficultyName(level)));
+    }
+    difficultyBox->setCurrentIndex(static_cast<int>(Difficulty::HARD));
+
+    // Clock for both modes (index order matches TimeControl::presets)
+    timeControlBox = new QComboBox();
+    timeControlBox->setObjectName("timeControlBox");
+    timeControlBox->setFixedHeight(40);
+    for (const TimeControl& control : TimeControl::presets()) {
+        timeControlBox->addItem("Clock: " + QString::fromStdString(control.toString()));
+    }
+
     playerButton = new QPushButton("👥 PLAY VS PLAYER");
     playerButton->setObjectName("gameModeButton");
     playerButton->setFixedHeight(80);
@@ -56,7 +73,9 @@ void GameModeWindow::setupUI()
     frameLayout->addWidget(welcomeLabel);
     frameLayout->addSpacing(30);
     frameLayout->addWidget(aiButton);
+    frameLayout->addWidget(difficultyBox);
     frameLayout->addWidget(playerButton);
+    frameLayout->addWidget(timeControlBox);
     frameLayout->addStretch();
     frameLayout->addWidget(backButton);
 
@@ -116,6 +135,21 @@ void GameModeWindow::applyStyles()
                 stop:0 rgba(255, 255, 255, 0.7), stop:1 rgba(255, 255, 255, 0.5));
         }
 
+        #difficultyBox, #timeControlBox {
+            background: rgba(255, 255, 255, 0.85);
+            color: #2c3e50;
+            border: none;
+            border-radius: 20px;
+            font-size: 14px;
+            font-weight: bold;
+            padding: 0 20px;
+        }
+
+        #difficultyBox::drop-down, #timeControlBox::drop-down {
+            border: none;
+            width: 30px;
+        }
+
         #backButton {
             background: rgba(255, 255, 255, 0.2);
             color: white;
@@ -139,7 +173,8 @@ void GameModeWindow::selectAIMode()
 {
     emit gameModeSelected(currentUsername, GameMode::AI);
 
-    MainWindow *mainWindow = new MainWindow(currentUsername);
+    Difficulty difficulty = static_cast<Difficulty>(difficultyBox->currentIndex());
+    MainWindow *mainWindow = new MainWindow(currentUsername, difficulty, selectedTimeControl());
     mainWindow->show();
     this->close();
 }
@@ -149,11 +184,16 @@ void GameModeWindow::selectPlayerMode()
     emit gameModeSelected(currentUsername, GameMode::PLAYER);
 
     // Use the new PlayerVsPlayerWindow for player vs player games
-    PlayerVsPlayerWindow *playerWindow = new PlayerVsPlayerWindow(currentUsername);
+    PlayerVsPlayerWindow *playerWindow = new PlayerVsPlayerWindow(currentUsername, selectedTimeControl());
     playerWindow->show();
     this->close();
 }
 
+TimeControl GameModeWindow::selectedTimeControl() const
+{
+    return TimeControl::presets()[timeControlBox->currentIndex()];
+}
+
 void GameModeWindow::goBack()
 {
     StartupWindow *startup = new StartupWindow();
@@ -1,35 +1,694 @@
-// History.cpp placeholder
 // History.cpp
 #include "History.h"
-#include <fstream>     // For reading/writing files (ifstream, ofstream)
-#include <sstream>     // For parsing strings using stringstream
+#include "HistoryArchive.h"
+#include "HistoryStore.h"
+#include "HistoryWriter.h"
+#include "Leaderboard.h"
+#include "MappedFile.h"
+#include <algorithm>   // For std::min
+#include <cctype>      // For std::tolower
+#include <chrono>      // For the current time
+#include <cstdio>      // For sscanf / snprintf / rename
+#include <cstring>     // For memcpy / memcmp
+#include <ctime>       // For mktime / localtime_r
+#include <filesystem>  // For checking which files exist
+#include <fstream>     // For reading legacy text files
+#include <limits>      // For "all records"
 
-History::History(const std::string& username) {
-    // Creates a filename like: history_omar.txt
-    filename = "history_" + username + ".txt";
+namespace {
+    // Per-user file of older versions: header, then recordCount records
+    struct HistoryHeader {
+        char magic[4];               // "TTTH"
+        std::uint16_t version;
+        std::uint16_t recordSize;    // sizeof(HistoryRecord), guards against layout changes
+        std::uint32_t recordCount;   // Records after the header; later bytes are a torn append
+        std::uint32_t checksum;      // FNV-1a over all records, extended on every append
+    };
+
+    static_assert(sizeof(HistoryHeader) == 16, "history header must stay 16 bytes");
+    static_assert(sizeof(HistoryRecord) == 16, "history record must stay 16 bytes");
+
+    const char HISTORY_MAGIC[4] = {'T', 'T', 'T', 'H'};
+    const std::uint16_t HISTORY_VERSION = 1;
+
+    const std::uint32_t FNV_OFFSET = 2166136261u;
+    const std::uint32_t FNV_PRIME = 16777619u;
+
+    std::uint32_t fnv1a(std::uint32_t hash, const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    // Header of a mapped history file; false if it is not one
+    bool readHeader(const MappedFile& file, HistoryHeader& header) {
+        if (file.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, HISTORY_MAGIC, sizeof(HISTORY_MAGIC)) != 0 ||
+            header.version != HISTORY_VERSION || header.recordSize != sizeof(HistoryRecord)) {
+            return false;
+        }
+
+        // A crash between writing a record and its header leaves extra bytes
+        std::size_t stored = (file.size() - sizeof(header)) / sizeof(HistoryRecord);
+        header.recordCount = static_cast<std::uint32_t>(std::min<std::size_t>(header.recordCount, stored));
+        return true;
+    }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date
+    std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+        unsigned yoe = static_cast<unsigned>(y - era * 400);
+        unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+    }
+
+    void civilFromDays(std::int64_t z, std::int64_t& y, unsigned& m, unsigned& d) {
+        z += 719468;
+        std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        unsigned doe = static_cast<unsigned>(z - era * 146097);
+        unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        unsigned mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = static_cast<std::int64_t>(yoe) + era * 400 + (m <= 2);
+    }
+
+    // Seconds since 1970 of a wall-clock time, as if it were UTC
+    std::int64_t civilSeconds(std::int64_t year, unsigned month, unsigned day, int hour, int minute, int second) {
+        return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    }
+
+    // Date and second of the day of seconds since 1970 (either scale)
+    void splitSeconds(std::int64_t timestamp, std::int64_t& year, unsigned& month, unsigned& day, int& second) {
+        std::int64_t days = timestamp / 86400;
+        std::int64_t rest = timestamp % 86400;
+        if (rest < 0) {
+            rest += 86400;
+            --days;
+        }
+        civilFromDays(days, year, month, day);
+        second = static_cast<int>(rest);
+    }
+
+    // UTC timestamp of a local wall-clock time; the hour repeated when
+    // daylight saving time ends is ambiguous, mktime picks one of the two
+    std::int64_t fromLocal(std::int64_t year, unsigned month, unsigned day, int hour, int minute, int second) {
+        std::tm local = {};
+        local.tm_year = static_cast<int>(year - 1900);
+        local.tm_mon = static_cast<int>(month) - 1;
+        local.tm_mday = static_cast<int>(day);
+        local.tm_hour = hour;
+        local.tm_min = minute;
+        local.tm_sec = second;
+        local.tm_isdst = -1;  // Whichever applies on that date
+        std::time_t time = std::mktime(&local);
+        if (time == static_cast<std::time_t>(-1)) {
+            return civilSeconds(year, month, day, hour, minute, second); // Out of the platform's range: as UTC
+        }
+        return static_cast<std::int64_t>(time);
+    }
+
+    // The same for a wall-clock time on the scale of civilSeconds, as older
+    // versions stored them
+    std::int64_t fromLocal(std::int64_t wallClock) {
+        std::int64_t year;
+        unsigned month, day;
+        int second;
+        splitSeconds(wallClock, year, month, day, second);
+        return fromLocal(year, month, day, second / 3600, second / 60 % 60, second % 60);
+    }
+
+    // Local wall-clock time of a UTC timestamp, on the scale of civilSeconds
+    std::int64_t toLocal(std::int64_t timestamp) {
+        std::time_t time = static_cast<std::time_t>(timestamp);
+        std::tm local;
+#ifdef _WIN32
+        bool converted = localtime_s(&local, &time) == 0;
+#else
+        bool converted = localtime_r(&time, &local) != nullptr;
+#endif
+        if (!converted) {
+            return timestamp;
+        }
+        return civilSeconds(local.tm_year + 1900, static_cast<unsigned>(local.tm_mon + 1),
+                            static_cast<unsigned>(local.tm_mday), local.tm_hour, local.tm_min, local.tm_sec);
+    }
+
+    std::string toLower(std::string text) {
+        for (char& ch : text) {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        return text;
+    }
+
+    bool startsWith(const std::string& text, const std::string& prefix) {
+        return text.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+double OutcomeTotals::winRate() const {
+    if (games == 0) return 0.0;
+    return static_cast<double>(wins) / static_cast<double>(games);
+}
+
+void OutcomeTotals::add(GameOutcome outcome) {
+    games++;
+    switch (outcome) {
+    case GameOutcome::WIN: wins++; break;
+    case GameOutcome::LOSS: losses++; break;
+    case GameOutcome::DRAW: draws++; break;
+    default: break;
+    }
+}
+
+void OutcomeTotals::add(const OutcomeTotals& other) {
+    games += other.games;
+    wins += other.wins;
+    losses += other.losses;
+    draws += other.draws;
+}
+
+void HistoryStats::add(const HistoryRecord& record) {
+    GameOutcome outcome = static_cast<GameOutcome>(record.outcome);
+    total.add(outcome);
+    byMode[record.mode < MODE_COUNT ? record.mode : 0].add(outcome);
+
+    // Unknown outcomes leave the streak alone
+    switch (outcome) {
+    case GameOutcome::WIN:
+        currentStreak = currentStreak > 0 ? currentStreak + 1 : 1;
+        bestWinStreak = std::max(bestWinStreak, static_cast<std::uint32_t>(currentStreak));
+        break;
+    case GameOutcome::LOSS:
+        currentStreak = currentStreak < 0 ? currentStreak - 1 : -1;
+        break;
+    case GameOutcome::DRAW:
+        currentStreak = 0;
+        break;
+    default:
+        break;
+    }
+
+    lastPlayed = std::max(lastPlayed, record.timestamp);
+    gamesCounted++;
+}
+
+const OutcomeTotals& HistoryStats::forMode(HistoryMode mode) const {
+    int index = static_cast<int>(mode);
+    return byMode[index < MODE_COUNT ? index : 0];
+}
+
+HistoryReader::Iterator::Iterator(const HistoryReader* reader, std::size_t index)
+    : reader(reader), index(index) {}
+
+GameResult HistoryReader::Iterator::operator*() const {
+    return reader->at(index);
+}
+
+HistoryRecord HistoryReader::Iterator::record() const {
+    return reader->record(index);
+}
+
+std::size_t HistoryReader::Iterator::position() const {
+    return index;
+}
+
+HistoryReader::Iterator& HistoryReader::Iterator::operator++() {
+    ++index;
+    return *this;
+}
+
+HistoryReader::Iterator HistoryReader::Iterator::operator++(int) {
+    Iterator previous = *this;
+    ++index;
+    return previous;
+}
+
+HistoryReader::Iterator& HistoryReader::Iterator::operator--() {
+    --index;
+    return *this;
+}
+
+HistoryReader::Iterator HistoryReader::Iterator::operator--(int) {
+    Iterator previous = *this;
+    --index;
+    return previous;
+}
+
+bool HistoryReader::Iterator::operator==(const Iterator& other) const {
+    return reader == other.reader && index == other.index;
+}
+
+bool HistoryReader::Iterator::operator!=(const Iterator& other) const {
+    return !(*this == other);
+}
+
+HistoryReader::HistoryReader()
+    : records(nullptr), recordCount(0), recordStride(sizeof(HistoryRecord)), archive(nullptr), archiveSize(0),
+      cachedBlock(0) {}
+
+HistoryReader::HistoryReader(const std::string& path) : HistoryReader() {
+    file.reset(new MappedFile());
+    HistoryHeader header;
+    if (file->open(path) && readHeader(*file, header)) {
+        records = file->data() + sizeof(header);
+        recordCount = header.recordCount;
+    }
+}
+
+HistoryReader::HistoryReader(std::unique_ptr<MappedFile> file, const unsigned char* records, std::size_t count,
+                             std::size_t stride, const unsigned char* archive, std::size_t archiveSize)
+    : file(std::move(file)), records(records), recordCount(count), recordStride(stride), archive(archive),
+      archiveSize(archiveSize), cachedBlock(0) {
+    // Only block headers are read here; a damaged one ends the archive
+    HistoryArchive::BlockInfo info;
+    std::size_t offset = 0;
+    while (offset < archiveSize && HistoryArchive::readInfo(archive + offset, archiveSize - offset, info) &&
+           info.count == HistoryArchive::BLOCK_RECORDS) {
+        blockOffsets.push_back(offset);
+        offset += HistoryArchive::blockSize(info);
+    }
+    cachedBlock = blockOffsets.size();
+}
+
+HistoryReader::~HistoryReader() = default;
+
+HistoryReader::HistoryReader(HistoryReader&& other) noexcept : HistoryReader() {
+    *this = std::move(other);
+}
+
+HistoryReader& HistoryReader::operator=(HistoryReader&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    file = std::move(other.file);
+    records = other.records;
+    recordCount = other.recordCount;
+    recordStride = other.recordStride;
+    archive = other.archive;
+    archiveSize = other.archiveSize;
+    blockOffsets = std::move(other.blockOffsets);
+    cachedBlock = other.cachedBlock;
+    cachedRecords = std::move(other.cachedRecords);
+    other.records = nullptr;
+    other.recordCount = 0;
+    other.archive = nullptr;
+    other.archiveSize = 0;
+    other.blockOffsets.clear();
+    other.cachedBlock = 0;
+    other.cachedRecords.clear();
+    return *this;
+}
+
+std::size_t HistoryReader::archivedCount() const {
+    return blockOffsets.size() * HistoryArchive::BLOCK_RECORDS;
+}
+
+const std::vector<HistoryRecord>& HistoryReader::block(std::size_t index) const {
+    if (cachedBlock != index) {
+        std::size_t offset = blockOffsets[index];
+        if (!HistoryArchive::decodeBlock(archive + offset, archiveSize - offset, cachedRecords)) {
+            cachedRecords.clear();
+        }
+        cachedBlock = index;
+    }
+    return cachedRecords;
+}
+
+std::size_t HistoryReader::size() const {
+    return archivedCount() + recordCount;
+}
+
+bool HistoryReader::empty() const {
+    return size() == 0;
+}
+
+HistoryRecord HistoryReader::record(std::size_t index) const {
+    HistoryRecord record;
+    std::size_t archived = archivedCount();
+    if (index < archived) {
+        const std::vector<HistoryRecord>& games = block(index / HistoryArchive::BLOCK_RECORDS);
+        if (games.empty()) {
+            // Damaged block (History::verify reports it)
+            record = HistoryRecord{0, static_cast<std::uint8_t>(GameOutcome::UNKNOWN), 0, 0, HistoryRecord::NO_MOVES};
+        } else {
+            record = games[index % HistoryArchive::BLOCK_RECORDS];
+        }
+        return record;
+    }
+    std::memcpy(&record, records + (index - archived) * recordStride, sizeof(record));
+    return record;
+}
+
+GameResult HistoryReader::at(std::size_t index) const {
+    return History::toResult(record(index));
+}
+
+std::size_t HistoryReader::lowerBound(std::int64_t timestamp) const {
+    // First the archived block whose time span reaches 'timestamp'
+    std::size_t first = 0, count = blockOffsets.size();
+    HistoryArchive::BlockInfo info;
+    while (count > 0) {
+        std::size_t half = count / 2;
+        std::size_t offset = blockOffsets[first + half];
+        HistoryArchive::readInfo(archive + offset, archiveSize - offset, info);
+        if (info.maxTime < timestamp) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    if (first < blockOffsets.size()) {
+        const std::vector<HistoryRecord>& games = block(first);
+        auto it = std::lower_bound(games.begin(), games.end(), timestamp,
+                                   [](const HistoryRecord& r, std::int64_t t) { return r.timestamp < t; });
+        return first * HistoryArchive::BLOCK_RECORDS + static_cast<std::size_t>(it - games.begin());
+    }
+
+    // Then the uncompressed records
+    first = archivedCount();
+    count = recordCount;
+    while (count > 0) {
+        std::size_t half = count / 2;
+        if (record(first + half).timestamp < timestamp) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+OutcomeTotals HistoryReader::totals(std::int64_t from, std::int64_t to) const {
+    OutcomeTotals totals;
+    if (from >= to) {
+        return totals;
+    }
+    HistoryArchive::BlockInfo info;
+    for (std::size_t b = 0; b < blockOffsets.size(); ++b) {
+        HistoryArchive::readInfo(archive + blockOffsets[b], archiveSize - blockOffsets[b], info);
+        if (info.maxTime < from || info.minTime >= to) continue;
+        if (info.minTime >= from && info.maxTime < to) {
+            totals.add(info.totals);
+            continue;
+        }
+        for (const HistoryRecord& game : block(b)) {
+            if (game.timestamp >= from && game.timestamp < to) {
+                totals.add(static_cast<GameOutcome>(game.outcome));
+            }
+        }
+    }
+
+    std::size_t last = lowerBound(to);
+    for (std::size_t i = std::max(archivedCount(), lowerBound(from)); i < last; ++i) {
+        totals.add(static_cast<GameOutcome>(record(i).outcome));
+    }
+    return totals;
+}
+
+HistoryReader::Iterator HistoryReader::begin() const {
+    return Iterator(this, 0);
+}
+
+HistoryReader::Iterator HistoryReader::end() const {
+    return Iterator(this, size());
+}
+
+HistoryReader::ReverseIterator HistoryReader::rbegin() const {
+    return ReverseIterator(end());
+}
+
+HistoryReader::ReverseIterator HistoryReader::rend() const {
+    return ReverseIterator(begin());
+}
+
+History::History(const std::string& username, HistoryWriter* writer, HistoryStore* store)
+    : username(username), writer(writer), store(store != nullptr ? store : &HistoryStore::shared()),
+      migrationChecked(false) {}
+
+void History::remove(const std::string& username, HistoryStore* store) {
+    if (store == nullptr) {
+        store = &HistoryStore::shared();
+    }
+    store->remove(username);
+    store->leaderboard().remove(username);
+    std::string base = "history_" + username;
+    for (const char* suffix : {".bin", ".bin.migrated", ".stats", ".txt", ".txt.migrated"}) {
+        std::error_code error;
+        std::filesystem::remove(base + suffix, error);
+    }
+}
+
+void History::migrate() const {
+    if (migrationChecked) return;
+    migrationChecked = true;
+
+    // Files like history_omar.bin, or history_omar.txt before that
+    std::string base = "history_" + username;
+    std::string binaryFile = base + ".bin";
+    std::string textFile = base + ".txt";
+    bool hasBinary = std::filesystem::exists(binaryFile);
+    bool hasText = std::filesystem::exists(textFile);
+    if (!hasBinary && !hasText) return;
+
+    // Only a crash can leave files behind after their games reached the store
+    if (store->open(username).empty()) {
+        std::vector<HistoryRecord> records;
+        if (hasBinary) {
+            HistoryReader legacy(binaryFile);
+            for (std::size_t i = 0; i < legacy.size(); ++i) {
+                records.push_back(legacy.record(i));
+                records.back().timestamp = fromLocal(records.back().timestamp); // Stored local time
+            }
+        } else {
+            std::ifstream in(textFile);
+            std::string line;
+            while (std::getline(in, line)) {
+                std::size_t comma = line.find(',');
+                if (comma == std::string::npos) continue;
+                GameResult res{line.substr(0, comma), line.substr(comma + 1)};
+                records.push_back(toRecord(res, 0)); // Unreadable dates sort first
+            }
+        }
+        HistoryStats stats;
+        if (!records.empty()) {
+            if (!store->append(username, records, true, &stats)) return;
+            store->leaderboard().update(username, stats.total);
+        }
+    }
+
+    // A binary file was converted from the text one, which is kept as it was
+    if (hasBinary) {
+        std::rename(binaryFile.c_str(), (binaryFile + ".migrated").c_str());
+    }
+    if (hasText) {
+        std::rename(textFile.c_str(), (textFile + ".migrated").c_str());
+    }
+    std::error_code error;
+    std::filesystem::remove(base + ".stats", error);
+}
+
+HistoryRecord History::toRecord(const GameResult& res, std::int64_t fallbackTime) const {
+    HistoryRecord record;
+    if (!parseDate(res.date, record.timestamp)) {
+        record.timestamp = fallbackTime;
+    }
+    record.outcome = static_cast<std::uint8_t>(parseOutcome(res.result));
+    record.mode = static_cast<std::uint8_t>(res.mode);
+    record.opponent = res.opponent;
+    record.moveOffset = HistoryRecord::NO_MOVES;
+    return record;
+}
+
+GameResult History::toResult(const HistoryRecord& record) {
+    GameResult res;
+    res.date = formatDate(record.timestamp);
+    res.result = outcomeName(static_cast<GameOutcome>(record.outcome));
+    res.mode = static_cast<HistoryMode>(record.mode);
+    res.opponent = record.opponent;
+    return res;
+}
+
+bool History::saveResult(const GameResult& res) {
+    HistoryRecord record = toRecord(res, currentTime());
+    if (writer != nullptr) {
+        writer->submit(*this, record);
+        return true; // The writer reports failures through flush
+    }
+    return commit({record}, false);
+}
+
+bool History::commit(const std::vector<HistoryRecord>& records, bool sync) const {
+    migrate();
+    HistoryStats stats;
+    if (!store->append(username, records, sync, &stats)) {
+        return false;
+    }
+    store->leaderboard().update(username, stats.total); // O(log users)
+    return true;
 }
 
+void History::flush() const {
+    if (writer != nullptr) {
+        writer->flush();
+    }
+}
 
-void History::saveResult(const GameResult& res) {
-    std::ofstream out(filename, std::ios::app);  // Open file in append mode
-    out << res.date << "," << res.result << "\n";  // Save result as: date,result
+HistoryStats History::getStats() const {
+    return snapshot().stats; // Kept up to date by every append
 }
 
+HistorySnapshot History::snapshot() const {
+    flush();
+    migrate();
+    return store->snapshot(username);
+}
 
 std::vector<GameResult> History::loadHistory() const {
-    std::ifstream in(filename);         // Open file for reading
-    std::string line;                   // Line buffer for reading file line by line
-    std::vector<GameResult> history;    // Vector to hold all parsed game results
+    return loadRange(0, std::numeric_limits<std::size_t>::max());  // The full history as a vector
+}
 
-    while (std::getline(in, line)) {
-        std::stringstream ss(line);     // Used to split line into parts
-        std::string date, result;
+HistoryReader History::reader() const {
+    flush();
+    migrate();
+    return store->open(username);
+}
 
-        // Split the line into 'date' and 'result' using comma
-        if (std::getline(ss, date, ',') && std::getline(ss, result)) {
-            history.push_back({date, result});  // Add parsed result to vector
+std::size_t History::count() const {
+    return snapshot().count;
+}
+
+std::vector<GameResult> History::loadRange(std::size_t offset, std::size_t count) const {
+    HistoryReader games = reader();
+    std::vector<GameResult> history;
+    if (offset >= games.size()) {
+        return history;
+    }
+
+    std::size_t last = offset + std::min(count, games.size() - offset);
+    history.reserve(last - offset);
+    for (std::size_t i = offset; i < last; ++i) {
+        history.push_back(games.at(i));
+    }
+    return history;
+}
+
+std::vector<GameResult> History::loadLatest(std::size_t n) const {
+    // Usually all in the cached snapshot
+    HistorySnapshot latest = snapshot();
+    if (n <= latest.latest.size() || latest.latest.size() == latest.count) {
+        std::vector<GameResult> history;
+        std::size_t first = latest.latest.size() - std::min(n, latest.latest.size());
+        history.reserve(latest.latest.size() - first);
+        for (std::size_t i = first; i < latest.latest.size(); ++i) {
+            history.push_back(toResult(latest.latest[i]));
         }
+        return history;
+    }
+
+    HistoryReader games = reader();
+    std::size_t first = games.size() - std::min(n, games.size());
+    std::vector<GameResult> history;
+    history.reserve(games.size() - first);
+    for (std::size_t i = first; i < games.size(); ++i) {
+        history.push_back(games.at(i));
+    }
+    return history;
+}
+
+std::vector<GameResult> History::query(std::int64_t from, std::int64_t to) const {
+    HistoryReader games = reader();
+    std::vector<GameResult> history;
+    if (from >= to) {
+        return history;
+    }
+    std::size_t first = games.lowerBound(from);
+    std::size_t last = games.lowerBound(to);
+    history.reserve(last - first);
+    for (std::size_t i = first; i < last; ++i) {
+        history.push_back(games.at(i));
+    }
+    return history;
+}
+
+OutcomeTotals History::totals(std::int64_t from, std::int64_t to) const {
+    return reader().totals(from, to);
+}
+
+bool History::verify() const {
+    flush();
+    migrate();
+    return store->verify(username);
+}
+
+GameOutcome History::parseOutcome(const std::string& text) const {
+    std::string lower = toLower(text);
+    if (lower.find("draw") != std::string::npos) {
+        return GameOutcome::DRAW;
     }
+    // "Win", "You win!", "You won", or the owner named as the winner
+    if (startsWith(lower, "win") || startsWith(lower, "you win") || startsWith(lower, "you won") ||
+        (!username.empty() && startsWith(lower, toLower(username) + " win"))) {
+        return GameOutcome::WIN;
+    }
+    // "Loss", "You lost", or anybody else winning
+    if (lower.find("loss") != std::string::npos || lower.find("lost") != std::string::npos ||
+        lower.find("lose") != std::string::npos || lower.find("win") != std::string::npos) {
+        return GameOutcome::LOSS;
+    }
+    return GameOutcome::UNKNOWN;
+}
+
+std::string History::outcomeName(GameOutcome outcome) {
+    switch (outcome) {
+    case GameOutcome::WIN: return "Win";
+    case GameOutcome::LOSS: return "Loss";
+    case GameOutcome::DRAW: return "Draw";
+    default: return "Unknown";
+    }
+}
+
+std::uint16_t History::opponentId(const std::string& name) {
+    if (name.empty()) return 0;
+    std::uint32_t hash = fnv1a(FNV_OFFSET, name.data(), name.size());
+    std::uint16_t id = static_cast<std::uint16_t>(hash ^ (hash >> 16));
+    return id == 0 ? 1 : id; // 0 means "no opponent"
+}
+
+bool History::parseDate(const std::string& date, std::int64_t& timestamp) {
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    int fields = std::sscanf(date.c_str(), "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    if (fields < 3 || fields == 4 || month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60) {
+        return false;
+    }
+    timestamp = fromLocal(year, static_cast<unsigned>(month), static_cast<unsigned>(day), hour, minute, second);
+    return true;
+}
+
+std::int64_t History::currentTime() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::string History::formatDate(std::int64_t timestamp) {
+    std::int64_t year;
+    unsigned month, day;
+    int second;
+    splitSeconds(toLocal(timestamp), year, month, day, second);
 
-    return history;  // Return the full history as a vector
+    char text[64];
+    std::snprintf(text, sizeof(text), "%04lld-%02u-%02u %02d:%02d:%02d", static_cast<long long>(year), month, day,
+                  second / 3600, second / 60 % 60, second % 60);
+    return text;
 }
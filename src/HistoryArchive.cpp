@@ -0,0 +1,232 @@
+// HistoryArchive.cpp
+#include "HistoryArchive.h"
+#include "Crc32c.h"
+#include <algorithm>
+#include <cstddef>     // For offsetof
+#include <cstring>     // For memcpy
+#include <map>
+
+namespace {
+    static_assert(sizeof(HistoryArchive::BlockInfo) == 48, "archive block header must stay 48 bytes");
+
+    void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    // Bits needed to tell 'values' values apart
+    int bitsFor(std::size_t values) {
+        int bits = 0;
+        while ((std::size_t(1) << bits) < values) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    // Packs fixed-width values, lowest bits first
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<unsigned char>& out) : out(out), pending(0), pendingBits(0) {}
+
+        void put(std::uint32_t value, int width) {
+            for (int bit = 0; bit < width; ++bit) {
+                pending |= ((value >> bit) & 1u) << pendingBits;
+                if (++pendingBits == 8) {
+                    out.push_back(static_cast<unsigned char>(pending));
+                    pending = 0;
+                    pendingBits = 0;
+                }
+            }
+        }
+
+        void finish() {
+            if (pendingBits > 0) {
+                out.push_back(static_cast<unsigned char>(pending));
+                pending = 0;
+                pendingBits = 0;
+            }
+        }
+
+    private:
+        std::vector<unsigned char>& out;
+        std::uint32_t pending;
+        int pendingBits;
+    };
+
+    // Reads columns back, failing (instead of reading past the end) on bad input
+    class Reader {
+    public:
+        Reader(const unsigned char* data, std::size_t size) : data(data), size(size), position(0) {}
+
+        bool varint(std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (position >= size) return false;
+                unsigned char byte = data[position++];
+                value |= std::uint64_t(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+
+        // 'count' values of 'width' bits, packed as by BitWriter
+        bool bits(std::size_t count, int width, std::vector<std::uint32_t>& values) {
+            std::size_t bytes = (count * width + 7) / 8;
+            if (bytes > size - position) return false;
+            values.assign(count, 0);
+            std::size_t bit = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                for (int b = 0; b < width; ++b, ++bit) {
+                    values[i] |= std::uint32_t((data[position + bit / 8] >> (bit % 8)) & 1u) << b;
+                }
+            }
+            position += bytes;
+            return true;
+        }
+
+        bool atEnd() const {
+            return position == size;
+        }
+
+    private:
+        const unsigned char* data;
+        std::size_t size;
+        std::size_t position;
+    };
+
+    // Distinct values, then each value's index in as few bits as possible
+    template <typename Field>
+    void encodeDictionary(const HistoryRecord* records, std::size_t count, Field field,
+                          std::vector<unsigned char>& out) {
+        std::map<std::uint32_t, std::uint32_t> dictionary;
+        for (std::size_t i = 0; i < count; ++i) {
+            dictionary.emplace(field(records[i]), 0);
+        }
+        putVarint(out, dictionary.size());
+        std::uint32_t index = 0;
+        for (auto& entry : dictionary) {
+            putVarint(out, entry.first);
+            entry.second = index++;
+        }
+
+        int width = bitsFor(dictionary.size());
+        BitWriter writer(out);
+        for (std::size_t i = 0; i < count; ++i) {
+            writer.put(dictionary[field(records[i])], width);
+        }
+        writer.finish();
+    }
+
+    bool decodeDictionary(Reader& reader, std::size_t count, std::uint64_t limit, std::vector<std::uint32_t>& values) {
+        std::uint64_t size = 0;
+        if (!reader.varint(size) || size > count || (count > 0 && size == 0)) return false;
+        std::vector<std::uint32_t> dictionary(size);
+        for (auto& value : dictionary) {
+            std::uint64_t stored = 0;
+            if (!reader.varint(stored) || stored > limit) return false;
+            value = static_cast<std::uint32_t>(stored);
+        }
+        if (!reader.bits(count, bitsFor(size), values)) return false;
+        for (auto& value : values) {
+            if (value >= size) return false;
+            value = dictionary[value];
+        }
+        return true;
+    }
+
+    std::uint32_t blockCrc(const HistoryArchive::BlockInfo& info, const unsigned char* columns) {
+        std::uint32_t crc = Crc32c::compute(&info, offsetof(HistoryArchive::BlockInfo, crc));
+        return Crc32c::extend(crc, columns, info.size);
+    }
+}
+
+void HistoryArchive::encodeBlock(const HistoryRecord* records, std::size_t count, std::vector<unsigned char>& out) {
+    BlockInfo info{};
+    info.count = static_cast<std::uint32_t>(count);
+    info.minTime = count > 0 ? records[0].timestamp : 0;
+    info.maxTime = info.minTime;
+    for (std::size_t i = 0; i < count; ++i) {
+        info.minTime = std::min(info.minTime, records[i].timestamp);
+        info.maxTime = std::max(info.maxTime, records[i].timestamp);
+        info.totals.add(static_cast<GameOutcome>(records[i].outcome));
+    }
+
+    std::vector<unsigned char> columns;
+    std::int64_t previous = info.minTime;
+    for (std::size_t i = 0; i < count; ++i) {
+        putVarint(columns, zigzag(records[i].timestamp - previous));
+        previous = records[i].timestamp;
+    }
+
+    BitWriter outcomes(columns);
+    for (std::size_t i = 0; i < count; ++i) {
+        outcomes.put(records[i].outcome & 3u, 2);
+    }
+    outcomes.finish();
+
+    encodeDictionary(records, count, [](const HistoryRecord& r) { return std::uint32_t(r.mode); }, columns);
+    encodeDictionary(records, count, [](const HistoryRecord& r) { return std::uint32_t(r.opponent); }, columns);
+    encodeDictionary(records, count, [](const HistoryRecord& r) { return r.moveOffset; }, columns);
+
+    info.size = static_cast<std::uint32_t>(columns.size());
+    info.crc = blockCrc(info, columns.data());
+    const unsigned char* header = reinterpret_cast<const unsigned char*>(&info);
+    out.insert(out.end(), header, header + sizeof(info));
+    out.insert(out.end(), columns.begin(), columns.end());
+}
+
+bool HistoryArchive::readInfo(const unsigned char* data, std::size_t available, BlockInfo& info) {
+    if (available < sizeof(info)) {
+        return false;
+    }
+    std::memcpy(&info, data, sizeof(info));
+    return info.count <= BLOCK_RECORDS && info.size <= available - sizeof(info);
+}
+
+bool HistoryArchive::decodeBlock(const unsigned char* data, std::size_t available,
+                                 std::vector<HistoryRecord>& records) {
+    BlockInfo info;
+    if (!readInfo(data, available, info) || blockCrc(info, data + sizeof(info)) != info.crc) {
+        return false;
+    }
+
+    Reader reader(data + sizeof(info), info.size);
+    records.assign(info.count, HistoryRecord());
+    std::int64_t previous = info.minTime;
+    for (auto& record : records) {
+        std::uint64_t delta = 0;
+        if (!reader.varint(delta)) return false;
+        record.timestamp = previous + unzigzag(delta);
+        previous = record.timestamp;
+    }
+
+    std::vector<std::uint32_t> column;
+    if (!reader.bits(info.count, 2, column)) return false;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].outcome = static_cast<std::uint8_t>(column[i]);
+    }
+    if (!decodeDictionary(reader, info.count, 0xFF, column)) return false;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].mode = static_cast<std::uint8_t>(column[i]);
+    }
+    if (!decodeDictionary(reader, info.count, 0xFFFF, column)) return false;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].opponent = static_cast<std::uint16_t>(column[i]);
+    }
+    if (!decodeDictionary(reader, info.count, 0xFFFFFFFFu, column)) return false;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].moveOffset = column[i];
+    }
+    return reader.atEnd();
+}
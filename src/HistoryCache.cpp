@@ -0,0 +1,122 @@
+// HistoryCache.cpp
+#include "HistoryCache.h"
+#include <algorithm>
+
+HistoryCache::HistoryCache() : HistoryCache(Options()) {}
+
+HistoryCache::HistoryCache(const Options& options)
+    : options(options), usedBytes(0), hitCount(0), missCount(0) {}
+
+std::size_t HistoryCache::nodeBytes(const Node& node) {
+    // The node, its name and games, and the map entry pointing to it
+    return sizeof(Node) + node.username.size() + node.snapshot.latest.capacity() * sizeof(HistoryRecord) +
+           sizeof(std::string) + sizeof(std::list<Node>::iterator) + node.username.size();
+}
+
+void HistoryCache::trim(std::vector<HistoryRecord>& latest) const {
+    if (latest.size() > options.recentGames) {
+        latest.erase(latest.begin(), latest.end() - static_cast<std::ptrdiff_t>(options.recentGames));
+    }
+}
+
+void HistoryCache::evict() {
+    while (usedBytes > options.capacityBytes && !order.empty()) {
+        usedBytes -= order.back().bytes;
+        nodes.erase(order.back().username);
+        order.pop_back();
+    }
+}
+
+bool HistoryCache::lookup(const std::string& username, HistorySnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = nodes.find(username);
+    if (it == nodes.end()) {
+        missCount++;
+        return false;
+    }
+    order.splice(order.begin(), order, it->second);
+    snapshot = it->second->snapshot;
+    hitCount++;
+    return true;
+}
+
+void HistoryCache::insert(const std::string& username, HistorySnapshot snapshot) {
+    trim(snapshot.latest);
+    snapshot.latest.shrink_to_fit();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = nodes.find(username);
+    if (it != nodes.end()) {
+        usedBytes -= it->second->bytes;
+        order.erase(it->second);
+        nodes.erase(it);
+    }
+
+    order.push_front(Node{username, std::move(snapshot), 0});
+    order.front().bytes = nodeBytes(order.front());
+    usedBytes += order.front().bytes;
+    nodes.emplace(username, order.begin());
+    evict();
+}
+
+void HistoryCache::append(const std::string& username, const HistoryStats& stats, std::size_t count,
+                          const std::vector<HistoryRecord>& records) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = nodes.find(username);
+    if (it == nodes.end()) {
+        return;
+    }
+    Node& node = *it->second;
+    node.snapshot.stats = stats;
+    node.snapshot.count = count;
+    std::vector<HistoryRecord>& latest = node.snapshot.latest;
+    std::size_t from = records.size() - std::min(records.size(), options.recentGames);
+    latest.insert(latest.end(), records.begin() + static_cast<std::ptrdiff_t>(from), records.end());
+    trim(latest);
+
+    usedBytes -= node.bytes;
+    node.bytes = nodeBytes(node);
+    usedBytes += node.bytes;
+    order.splice(order.begin(), order, it->second);  // Whoever just played is likely to look next
+    evict();
+}
+
+void HistoryCache::erase(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = nodes.find(username);
+    if (it != nodes.end()) {
+        usedBytes -= it->second->bytes;
+        order.erase(it->second);
+        nodes.erase(it);
+    }
+}
+
+void HistoryCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.clear();
+    nodes.clear();
+    usedBytes = 0;
+}
+
+std::size_t HistoryCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nodes.size();
+}
+
+std::size_t HistoryCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usedBytes;
+}
+
+std::uint64_t HistoryCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+std::uint64_t HistoryCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
+
+std::size_t HistoryCache::recentGames() const {
+    return options.recentGames;
+}
@@ -0,0 +1,951 @@
+// HistoryStore.cpp
+#include "HistoryStore.h"
+#include "Crc32c.h"
+#include "HistoryArchive.h"
+#include "Leaderboard.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstddef>     // For offsetof
+#include <cstdio>      // For snprintf
+#include <cstring>     // For memcpy / memcmp
+#include <filesystem>  // For creating the shard directory
+#include <fstream>
+#include <functional>
+#include <iterator>    // For back_inserter
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>     // open
+#include <unistd.h>    // fsync, close
+#endif
+
+namespace {
+    // Shard layout: two header copies, the user index, then names and
+    // record regions in allocation order. Headers and index entries are
+    // written to alternating copies with a rising sequence number, so a torn
+    // write always leaves the previous copy intact. Structural changes (new
+    // users, moved regions, a grown index) are always synced; plain appends
+    // only every CHECKPOINT_RECORDS records unless asked to.
+    struct ShardHeader {
+        char magic[4];               // "TTTD"
+        std::uint16_t version;
+        std::uint16_t entrySize;     // sizeof(UserEntry), guards against layout changes
+        std::uint32_t recordSize;    // sizeof(HistoryRecord)
+        std::uint32_t sequence;      // Newest valid copy wins
+        std::uint64_t indexOffset;
+        std::uint32_t indexSlots;    // Power of two; each slot holds two UserEntry copies
+        std::uint32_t usedSlots;     // Live + deleted slots, bounds probe chains
+        std::uint32_t userCount;     // Live users
+        std::uint32_t reserved;
+        std::uint64_t fileEnd;       // Allocation point; later bytes are a torn write
+        std::uint64_t garbage;       // Bytes of moved regions, old indexes, removed users
+        std::uint32_t checksum;      // CRC-32C of the bytes above
+        std::uint32_t reserved2;
+    };
+
+    enum SlotState : std::uint32_t { SLOT_EMPTY = 0, SLOT_LIVE = 1, SLOT_DELETED = 2 };
+
+    struct UserEntry {
+        std::uint64_t nameHash;
+        std::uint64_t nameOffset;
+        std::uint32_t nameLength;
+        std::uint32_t state;         // SlotState
+        std::uint64_t regionOffset;  // The user's latest records as frames, sorted by time
+        std::uint32_t regionCapacity;  // In frames
+        std::uint32_t recordCount;   // Frames in the region
+        std::uint32_t durableCount;  // Frames synced to disk; recovery checks only later ones
+        std::uint32_t sequence;      // Newest valid copy wins
+        std::uint64_t archiveOffset; // HistoryArchive blocks of the oldest records
+        std::uint32_t archiveCapacity;  // In bytes
+        std::uint32_t archiveSize;   // Bytes in use
+        std::uint32_t archivedCount; // Records in the archive, all older than the frames
+        std::uint32_t reserved2;
+        HistoryStats stats;
+        std::uint32_t checksum;      // CRC-32C of the bytes above
+        std::uint32_t reserved;
+    };
+
+    // A record with its length and a CRC-32C of both, so one that never
+    // fully reached the disk is recognised
+    struct RecordFrame {
+        std::uint32_t length;        // sizeof(HistoryRecord)
+        std::uint32_t crc;
+        HistoryRecord record;
+    };
+
+    static_assert(sizeof(HistoryStats) == 120, "history stats layout is part of the shard format");
+    static_assert(sizeof(ShardHeader) == 64, "shard header must stay 64 bytes");
+    static_assert(sizeof(UserEntry) == 200, "user entry must stay 200 bytes");
+    static_assert(sizeof(RecordFrame) == 24, "record frame must stay 24 bytes");
+
+    const char SHARD_MAGIC[4] = {'T', 'T', 'T', 'D'};
+    const std::uint16_t SHARD_VERSION = 4;       // 1 stored bare records and FNV-1a checksums, 2 had no archive,
+                                                 // 3 stored local time
+    const std::uint64_t SLOT_SIZE = 2 * sizeof(UserEntry);
+    const std::uint32_t INITIAL_SLOTS = 64;
+    const std::uint32_t INITIAL_CAPACITY = 16;  // Records in a new user's region
+    const std::uint32_t CHECKPOINT_RECORDS = 64; // Unsynced records at most, bounding recovery
+    const std::size_t ARCHIVE_AFTER = 2 * HistoryArchive::BLOCK_RECORDS;  // Frames that start a compaction
+    const std::uint32_t INITIAL_ARCHIVE = 4096;  // Bytes in a user's first archive region
+    const std::uint64_t VACUUM_AFTER = 64 * 1024; // Shard size before garbage is worth reclaiming
+
+    void seal(ShardHeader& header) {
+        header.checksum = Crc32c::compute(&header, offsetof(ShardHeader, checksum));
+    }
+
+    void seal(UserEntry& entry) {
+        entry.checksum = Crc32c::compute(&entry, offsetof(UserEntry, checksum));
+    }
+
+    std::uint32_t frameCrc(const RecordFrame& frame) {
+        return Crc32c::extend(Crc32c::compute(&frame.length, sizeof(frame.length)), &frame.record, sizeof(frame.record));
+    }
+
+    RecordFrame toFrame(const HistoryRecord& record) {
+        RecordFrame frame;
+        frame.length = sizeof(HistoryRecord);
+        frame.record = record;
+        frame.crc = frameCrc(frame);
+        return frame;
+    }
+
+    bool isValid(const ShardHeader& header) {
+        return std::memcmp(header.magic, SHARD_MAGIC, sizeof(SHARD_MAGIC)) == 0 &&
+               header.version == SHARD_VERSION && header.entrySize == sizeof(UserEntry) &&
+               header.recordSize == sizeof(HistoryRecord) &&
+               header.checksum == Crc32c::compute(&header, offsetof(ShardHeader, checksum));
+    }
+
+    bool isValid(const UserEntry& entry) {
+        return entry.checksum == Crc32c::compute(&entry, offsetof(UserEntry, checksum));
+    }
+
+    bool isValid(const RecordFrame& frame) {
+        return frame.length == sizeof(HistoryRecord) && frame.crc == frameCrc(frame);
+    }
+
+    // Reads 'size' bytes at 'offset' of a shard; false past its end
+    using ReadAt = std::function<bool(std::uint64_t offset, void* data, std::size_t size)>;
+
+    // Newest valid header copy
+    bool loadHeader(const ReadAt& read, ShardHeader& header) {
+        bool found = false;
+        for (int copy = 0; copy < 2; ++copy) {
+            ShardHeader candidate;
+            if (read(copy * sizeof(ShardHeader), &candidate, sizeof(candidate)) && isValid(candidate) &&
+                (!found || candidate.sequence > header.sequence)) {
+                header = candidate;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // Newest valid entry copy of a slot; a slot with no valid copy is empty
+    // if it was never written and deleted (reusable) otherwise
+    bool loadSlot(const ReadAt& read, const ShardHeader& header, std::uint32_t slot, UserEntry& entry) {
+        UserEntry copies[2];
+        if (!read(header.indexOffset + slot * SLOT_SIZE, copies, sizeof(copies))) {
+            return false;
+        }
+        bool found = false;
+        for (const UserEntry& copy : copies) {
+            if (isValid(copy) && (!found || copy.sequence > entry.sequence)) {
+                entry = copy;
+                found = true;
+            }
+        }
+        if (!found) {
+            entry = copies[0];
+            entry.state = (copies[0].state == SLOT_EMPTY && copies[1].state == SLOT_EMPTY) ? SLOT_EMPTY : SLOT_DELETED;
+            entry.sequence = std::max(copies[0].sequence, copies[1].sequence);
+        }
+        return true;
+    }
+
+    // Number of leading records of 'entry' that are intact. Only records
+    // after durableCount can have been lost in a crash, so recovery checks
+    // just those; 'all' checks every record instead
+    std::uint32_t intactRecords(const ReadAt& read, const UserEntry& entry, bool all = false) {
+        std::uint32_t first = all ? 0 : std::min(entry.durableCount, entry.recordCount);
+        for (std::uint32_t i = first; i < entry.recordCount; ++i) {
+            RecordFrame frame;
+            if (!read(entry.regionOffset + std::uint64_t(i) * sizeof(frame), &frame, sizeof(frame)) || !isValid(frame)) {
+                return i;
+            }
+        }
+        return entry.recordCount;
+    }
+
+    // The first 'count' records of 'entry'
+    bool loadRecords(const ReadAt& read, const UserEntry& entry, std::uint32_t count, std::vector<HistoryRecord>& records) {
+        std::vector<RecordFrame> frames(count);
+        if (!frames.empty() && !read(entry.regionOffset, frames.data(), frames.size() * sizeof(RecordFrame))) {
+            return false;
+        }
+        records.clear();
+        records.reserve(count);
+        for (const RecordFrame& frame : frames) {
+            records.push_back(frame.record);
+        }
+        return true;
+    }
+
+    // Every record of 'entry': the archived ones, then the first 'frames' frames
+    bool loadAll(const ReadAt& read, const UserEntry& entry, std::uint32_t frames, std::vector<HistoryRecord>& records) {
+        std::vector<unsigned char> archive(entry.archiveSize);
+        if (!archive.empty() && !read(entry.archiveOffset, archive.data(), archive.size())) {
+            return false;
+        }
+        records.clear();
+        std::vector<HistoryRecord> block;
+        HistoryArchive::BlockInfo info;
+        for (std::size_t offset = 0; offset < archive.size(); offset += HistoryArchive::blockSize(info)) {
+            if (!HistoryArchive::readInfo(archive.data() + offset, archive.size() - offset, info) ||
+                !HistoryArchive::decodeBlock(archive.data() + offset, archive.size() - offset, block)) {
+                return false;
+            }
+            records.insert(records.end(), block.begin(), block.end());
+        }
+        if (records.size() != entry.archivedCount) {
+            return false;
+        }
+
+        std::vector<HistoryRecord> latest;
+        if (!loadRecords(read, entry, frames, latest)) {
+            return false;
+        }
+        records.insert(records.end(), latest.begin(), latest.end());
+        return true;
+    }
+
+    HistoryStats countStats(const std::vector<HistoryRecord>& records) {
+        HistoryStats stats;
+        for (const HistoryRecord& record : records) {
+            stats.add(record);
+        }
+        return stats;
+    }
+
+    // Where a user is (or would go) in the index
+    struct Probe {
+        bool found = false;
+        bool slotWasEmpty = false;   // The free slot for a new user was never used
+        std::uint32_t slot = 0;
+        UserEntry entry{};
+    };
+
+    bool probe(const ReadAt& read, const ShardHeader& header, const std::string& name,
+               std::uint64_t hash, Probe& result) {
+        std::uint32_t mask = header.indexSlots - 1;
+        std::uint32_t slot = static_cast<std::uint32_t>(hash >> 8) & mask;
+        bool haveFree = false;
+        for (std::uint32_t i = 0; i < header.indexSlots; ++i, slot = (slot + 1) & mask) {
+            UserEntry entry;
+            if (!loadSlot(read, header, slot, entry)) {
+                return false;
+            }
+            if (entry.state != SLOT_LIVE) {
+                if (!haveFree) {
+                    haveFree = true;
+                    result.slot = slot;
+                    result.slotWasEmpty = entry.state == SLOT_EMPTY;
+                    result.entry = entry;    // Keeps the slot's sequence rising
+                }
+                if (entry.state == SLOT_EMPTY) {
+                    return true;             // End of the probe chain
+                }
+                continue;
+            }
+            if (entry.nameHash == hash && entry.nameLength == name.size()) {
+                std::string stored(name.size(), '\0');
+                if (!stored.empty() && !read(entry.nameOffset, &stored[0], stored.size())) {
+                    return false;
+                }
+                if (stored == name) {
+                    result.found = true;
+                    result.slot = slot;
+                    result.entry = entry;
+                    return true;
+                }
+            }
+        }
+        return haveFree;
+    }
+
+    // Forces a file's written data to disk
+    void syncFile(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file != INVALID_HANDLE_VALUE) {
+            FlushFileBuffers(file);
+            CloseHandle(file);
+        }
+#else
+        int fd = ::open(path.c_str(), O_WRONLY);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+#endif
+    }
+
+    // A shard opened for update
+    class ShardFile {
+    public:
+        bool open(const std::string& path) {
+            this->path = path;
+            file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+            return file.is_open();
+        }
+
+        // A read past the end (a frame torn by a crash) sets the stream's
+        // failure state; each call clears it, so one failure never sticks
+        bool read(std::uint64_t offset, void* data, std::size_t size) {
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(offset));
+            return static_cast<bool>(file.read(static_cast<char*>(data), static_cast<std::streamsize>(size)));
+        }
+
+        std::uint64_t size() {
+            file.clear();
+            file.seekg(0, std::ios::end);
+            return static_cast<std::uint64_t>(file.tellg());
+        }
+
+        bool write(std::uint64_t offset, const void* data, std::size_t size) {
+            file.clear();
+            file.seekp(static_cast<std::streamoff>(offset));
+            return static_cast<bool>(file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size)));
+        }
+
+        // Everything written so far reaches the OS (and the disk with 'sync')
+        // before anything written afterwards
+        bool barrier(bool sync) {
+            file.flush();
+            if (sync) {
+                syncFile(path);
+            }
+            return file.good();
+        }
+
+        void close() {
+            file.close();
+        }
+
+        ReadAt reader() {
+            return [this](std::uint64_t offset, void* data, std::size_t size) { return read(offset, data, size); };
+        }
+
+    private:
+        std::string path;
+        std::fstream file;
+    };
+
+    ReadAt mappedReader(const MappedFile& file) {
+        return [&file](std::uint64_t offset, void* data, std::size_t size) {
+            if (offset > file.size() || size > file.size() - offset) {
+                return false;
+            }
+            std::memcpy(data, file.data() + offset, size);
+            return true;
+        };
+    }
+
+    std::uint64_t allocate(ShardHeader& header, std::uint64_t size) {
+        std::uint64_t offset = header.fileEnd;
+        header.fileEnd += (size + 7) & ~std::uint64_t(7);
+        return offset;
+    }
+
+    bool writeHeader(ShardFile& file, ShardHeader& header) {
+        header.sequence++;
+        seal(header);
+        return file.write((header.sequence % 2) * sizeof(ShardHeader), &header, sizeof(header));
+    }
+
+    bool writeEntry(ShardFile& file, const ShardHeader& header, std::uint32_t slot, UserEntry& entry) {
+        entry.sequence++;
+        seal(entry);
+        return file.write(header.indexOffset + slot * SLOT_SIZE + (entry.sequence % 2) * sizeof(UserEntry),
+                          &entry, sizeof(entry));
+    }
+
+    // Header of a shard whose index of 'slots' slots follows the headers
+    ShardHeader newHeader(std::uint32_t slots) {
+        ShardHeader header{};
+        std::memcpy(header.magic, SHARD_MAGIC, sizeof(SHARD_MAGIC));
+        header.version = SHARD_VERSION;
+        header.entrySize = sizeof(UserEntry);
+        header.recordSize = sizeof(HistoryRecord);
+        header.sequence = 0;
+        header.indexOffset = 2 * sizeof(ShardHeader);
+        header.indexSlots = slots;
+        header.fileEnd = header.indexOffset + slots * SLOT_SIZE;
+        return header;
+    }
+
+    // Writes an empty shard
+    bool createShard(const std::string& path) {
+        std::vector<unsigned char> bytes(2 * sizeof(ShardHeader) + INITIAL_SLOTS * SLOT_SIZE, 0);
+        ShardHeader header = newHeader(INITIAL_SLOTS);
+        seal(header);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return out.good();
+    }
+
+    // Adds encoded blocks after the user's archive, moving it to twice the
+    // room when full; like frames, they count once the entry is written
+    bool appendArchive(ShardFile& file, ShardHeader& header, UserEntry& entry, const std::vector<unsigned char>& blocks) {
+        std::uint64_t needed = std::uint64_t(entry.archiveSize) + blocks.size();
+        if (needed > entry.archiveCapacity) {
+            std::uint64_t capacity = std::max<std::uint64_t>(INITIAL_ARCHIVE, entry.archiveCapacity);
+            while (capacity < needed) {
+                capacity *= 2;
+            }
+            std::uint64_t offset = allocate(header, capacity);
+            std::vector<unsigned char> existing(entry.archiveSize);
+            if (!existing.empty() &&
+                (!file.read(entry.archiveOffset, existing.data(), existing.size()) ||
+                 !file.write(offset, existing.data(), existing.size()))) {
+                return false;
+            }
+            header.garbage += entry.archiveCapacity;
+            entry.archiveOffset = offset;
+            entry.archiveCapacity = static_cast<std::uint32_t>(capacity);
+        }
+        if (!blocks.empty() && !file.write(entry.archiveOffset + entry.archiveSize, blocks.data(), blocks.size())) {
+            return false;
+        }
+        entry.archiveSize = static_cast<std::uint32_t>(needed);
+        return true;
+    }
+
+    // Moves the live users into an index twice as large
+    bool growIndex(ShardFile& file, ShardHeader& header, bool sync) {
+        std::uint32_t slots = header.indexSlots * 2;
+        std::vector<UserEntry> table(std::size_t(slots) * 2, UserEntry{});
+        std::uint32_t users = 0;
+        for (std::uint32_t slot = 0; slot < header.indexSlots; ++slot) {
+            UserEntry entry;
+            if (!loadSlot(file.reader(), header, slot, entry)) {
+                return false;
+            }
+            if (entry.state != SLOT_LIVE) continue;
+
+            std::uint32_t target = static_cast<std::uint32_t>(entry.nameHash >> 8) & (slots - 1);
+            while (table[target * 2].state != SLOT_EMPTY || table[target * 2 + 1].state != SLOT_EMPTY) {
+                target = (target + 1) & (slots - 1);
+            }
+            table[target * 2 + entry.sequence % 2] = entry;
+            users++;
+        }
+
+        std::uint64_t offset = allocate(header, std::uint64_t(slots) * SLOT_SIZE);
+        if (!file.write(offset, table.data(), table.size() * sizeof(UserEntry)) || !file.barrier(sync)) {
+            return false;
+        }
+        header.garbage += std::uint64_t(header.indexSlots) * SLOT_SIZE;
+        header.indexOffset = offset;
+        header.indexSlots = slots;
+        header.usedSlots = users;
+        header.userCount = users;
+        return writeHeader(file, header) && file.barrier(sync);
+    }
+
+    std::uint64_t align8(std::uint64_t size) {
+        return (size + 7) & ~std::uint64_t(7);
+    }
+
+    // Forgets the user's cached snapshot unless the append is stored whole
+    struct CacheGuard {
+        HistoryCache& cache;
+        const std::string& username;
+        bool stored = false;
+
+        ~CacheGuard() {
+            if (!stored) cache.erase(username);
+        }
+    };
+
+    // Rewrites the shard with only the live users' data, as a new file
+    // renamed over the old one, so readers still mapping it are unaffected.
+    // Best effort: on any failure the old shard stays as it is.
+    void vacuum(ShardFile& file, const std::string& path, const ShardHeader& header) {
+        struct Live {
+            UserEntry old;
+            UserEntry entry;
+        };
+        std::vector<Live> users;
+        for (std::uint32_t slot = 0; slot < header.indexSlots; ++slot) {
+            UserEntry entry;
+            if (!loadSlot(file.reader(), header, slot, entry)) return;
+            if (entry.state != SLOT_LIVE) continue;
+
+            Live user{entry, entry};
+            user.entry.recordCount = intactRecords(file.reader(), entry);
+            if (user.entry.recordCount < entry.recordCount) {
+                std::vector<HistoryRecord> kept;
+                if (!loadAll(file.reader(), entry, user.entry.recordCount, kept)) return;
+                user.entry.stats = countStats(kept);
+            }
+            users.push_back(user);
+        }
+
+        // Index at most 70% full, then each user's name, archive and region
+        std::uint32_t slots = INITIAL_SLOTS;
+        while ((users.size() + 1) * 10 > slots * 7) {
+            slots *= 2;
+        }
+        ShardHeader compacted = newHeader(slots);
+        std::vector<UserEntry> table(std::size_t(slots) * 2, UserEntry{});
+        for (Live& user : users) {
+            UserEntry& entry = user.entry;
+            entry.nameOffset = allocate(compacted, entry.nameLength);
+            entry.archiveOffset = allocate(compacted, entry.archiveSize);
+            entry.archiveCapacity = entry.archiveSize;
+            entry.regionCapacity = std::max(INITIAL_CAPACITY, entry.recordCount * 2);
+            entry.regionOffset = allocate(compacted, std::uint64_t(entry.regionCapacity) * sizeof(RecordFrame));
+            entry.durableCount = entry.recordCount; // The new file is synced before it is used
+            entry.sequence = 1;
+            seal(entry);
+
+            std::uint32_t target = static_cast<std::uint32_t>(entry.nameHash >> 8) & (slots - 1);
+            while (table[target * 2 + 1].state != SLOT_EMPTY) {
+                target = (target + 1) & (slots - 1);
+            }
+            table[target * 2 + 1] = entry;
+        }
+        compacted.usedSlots = static_cast<std::uint32_t>(users.size());
+        compacted.userCount = static_cast<std::uint32_t>(users.size());
+        seal(compacted);
+
+        // Written in allocation order, so the file is one sequential write
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            ShardHeader unused{};
+            out.write(reinterpret_cast<const char*>(&compacted), sizeof(compacted));
+            out.write(reinterpret_cast<const char*>(&unused), sizeof(unused));
+            out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(UserEntry)));
+
+            std::vector<unsigned char> bytes;
+            auto copy = [&](std::uint64_t from, std::uint64_t size, std::uint64_t room) {
+                bytes.assign(room, 0);
+                if (size > 0 && !file.read(from, bytes.data(), size)) return false;
+                out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(room));
+                return true;
+            };
+            for (const Live& user : users) {
+                const UserEntry& entry = user.entry;
+                if (!copy(user.old.nameOffset, entry.nameLength, align8(entry.nameLength)) ||
+                    !copy(user.old.archiveOffset, entry.archiveSize, align8(entry.archiveSize)) ||
+                    !copy(user.old.regionOffset, std::uint64_t(entry.recordCount) * sizeof(RecordFrame),
+                          std::uint64_t(entry.regionCapacity) * sizeof(RecordFrame))) {
+                    out.close();
+                    std::remove(temporary.c_str());
+                    return;
+                }
+            }
+            if (!out.good()) {
+                out.close();
+                std::remove(temporary.c_str());
+                return;
+            }
+        }
+        syncFile(temporary);
+
+        file.close();
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error); // Fails while mapped on Windows: keep the old shard
+        if (error) {
+            std::remove(temporary.c_str());
+        }
+    }
+}
+
+HistoryStore::HistoryStore(const std::string& directory, const HistoryCache::Options& cacheOptions)
+    : directory(directory), cache(cacheOptions) {}
+
+HistoryStore::~HistoryStore() = default;
+
+Leaderboard& HistoryStore::leaderboard() {
+    std::call_once(boardOpened, [this] {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        std::string path = directory + "/leaderboard.db";
+        bool seed = !std::filesystem::exists(path, error);
+        board.reset(new Leaderboard(path));
+        if (seed) {
+            board->assign(storedTotals());
+        }
+    });
+    return *board;
+}
+
+std::vector<LeaderboardEntry> HistoryStore::storedTotals() const {
+    std::vector<LeaderboardEntry> users;
+    for (int shard = 0; shard < SHARD_COUNT; ++shard) {
+        std::lock_guard<std::mutex> lock(shardLocks[shard]);
+        MappedFile file;
+        ShardHeader header;
+        if (!file.open(shardFile(shard)) || !loadHeader(mappedReader(file), header)) {
+            continue;
+        }
+        ReadAt read = mappedReader(file);
+        for (std::uint32_t slot = 0; slot < header.indexSlots; ++slot) {
+            UserEntry entry;
+            if (!loadSlot(read, header, slot, entry)) break;
+            if (entry.state != SLOT_LIVE) continue;
+
+            LeaderboardEntry user;
+            user.username.resize(entry.nameLength);
+            if (!read(entry.nameOffset, &user.username[0], entry.nameLength)) continue;
+            user.totals = entry.stats.total;
+            users.push_back(user);
+        }
+    }
+    return users;
+}
+
+HistoryStore& HistoryStore::shared() {
+    static HistoryStore store;
+    return store;
+}
+
+const std::string& HistoryStore::getDirectory() const {
+    return directory;
+}
+
+HistoryCache& HistoryStore::getCache() const {
+    return cache;
+}
+
+std::uint64_t HistoryStore::nameHash(const std::string& username) {
+    // 64-bit FNV-1a: low bits pick the shard, higher bits the index slot
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char ch : username) {
+        hash = (hash ^ ch) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string HistoryStore::shardFile(int shard) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/shard_%02d.db", shard);
+    return directory + name;
+}
+
+std::string HistoryStore::shardPath(const std::string& username) const {
+    return shardFile(static_cast<int>(nameHash(username) % SHARD_COUNT));
+}
+
+bool HistoryStore::append(const std::string& username, const std::vector<HistoryRecord>& records, bool sync,
+                          HistoryStats* updated) {
+    if (records.empty()) {
+        return true;
+    }
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+    CacheGuard cached{cache, username};
+
+    std::string path = shardFile(shard);
+    ShardFile file;
+    if (!file.open(path)) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (!createShard(path) || !file.open(path)) {
+            return false;
+        }
+    }
+
+    ShardHeader header;
+    Probe place;
+    if (!loadHeader(file.reader(), header) || !probe(file.reader(), header, username, hash, place)) {
+        return false; // Damaged shard: never overwrite it
+    }
+    // A header lost in a crash must not hand out space that is in use
+    header.fileEnd = std::max(header.fileEnd, (file.size() + 7) & ~std::uint64_t(7));
+
+    UserEntry entry = place.entry;
+    bool durable = sync;
+    if (!place.found) {
+        // New user: keep the index at most 70% full
+        if ((header.usedSlots + 1) * 10 > header.indexSlots * 7) {
+            if (!growIndex(file, header, true)) return false;
+            place = Probe();
+            if (!probe(file.reader(), header, username, hash, place)) return false;
+            entry = place.entry;
+        }
+
+        std::uint32_t sequence = entry.sequence;
+        entry = UserEntry{};
+        entry.sequence = sequence;
+        entry.nameHash = hash;
+        entry.nameLength = static_cast<std::uint32_t>(username.size());
+        entry.nameOffset = allocate(header, username.size());
+        entry.state = SLOT_LIVE;
+        if (!file.write(entry.nameOffset, username.data(), username.size())) return false;
+
+        header.userCount++;
+        if (place.slotWasEmpty) {
+            header.usedSlots++;
+        }
+        durable = true;
+    } else {
+        // Recovery: records after the last sync that never reached the disk
+        // whole are dropped, and the stats recounted without them
+        std::uint32_t intact = intactRecords(file.reader(), entry);
+        if (intact < entry.recordCount) {
+            std::vector<HistoryRecord> kept;
+            if (!loadAll(file.reader(), entry, intact, kept)) return false;
+            entry.recordCount = intact;
+            entry.stats = countStats(kept);
+        }
+    }
+
+    // Records are kept sorted by time. Games saved in order are appended;
+    // older ones (imports, a clock set back) are merged into a new region so
+    // the stored records are never rewritten in place
+    auto byTime = [](const HistoryRecord& a, const HistoryRecord& b) { return a.timestamp < b.timestamp; };
+    bool inOrder = std::is_sorted(records.begin(), records.end(), byTime) &&
+                   (entry.archivedCount + entry.recordCount == 0 || records.front().timestamp >= entry.stats.lastPlayed);
+    if (!inOrder || std::uint64_t(entry.recordCount) + records.size() > entry.regionCapacity) {
+        std::vector<HistoryRecord> latest;   // Records for the new region
+        if (!inOrder) {
+            // Everything is merged, and archived again
+            std::vector<HistoryRecord> existing;
+            if (!loadAll(file.reader(), entry, entry.recordCount, existing)) {
+                return false;
+            }
+            std::vector<HistoryRecord> added(records);
+            std::stable_sort(added.begin(), added.end(), byTime);
+            latest.reserve(existing.size() + added.size());
+            std::merge(existing.begin(), existing.end(), added.begin(), added.end(), std::back_inserter(latest), byTime);
+            entry.stats = countStats(latest); // Streaks follow the new order
+
+            header.garbage += entry.archiveCapacity;
+            entry.archiveOffset = 0;
+            entry.archiveCapacity = 0;
+            entry.archiveSize = 0;
+            entry.archivedCount = 0;
+        } else if (!loadRecords(file.reader(), entry, entry.recordCount, latest)) {
+            return false;
+        }
+
+        // Compaction: whole blocks of the oldest records go to the archive,
+        // leaving at least a block's worth as frames for the next appends
+        if (latest.size() >= ARCHIVE_AFTER) {
+            std::size_t blocks = (latest.size() - HistoryArchive::BLOCK_RECORDS) / HistoryArchive::BLOCK_RECORDS;
+            std::size_t archived = blocks * HistoryArchive::BLOCK_RECORDS;
+            std::vector<unsigned char> encoded;
+            for (std::size_t block = 0; block < blocks; ++block) {
+                HistoryArchive::encodeBlock(latest.data() + block * HistoryArchive::BLOCK_RECORDS,
+                                            HistoryArchive::BLOCK_RECORDS, encoded);
+            }
+            if (!appendArchive(file, header, entry, encoded)) {
+                return false;
+            }
+            entry.archivedCount += static_cast<std::uint32_t>(archived);
+            latest.erase(latest.begin(), latest.begin() + static_cast<std::ptrdiff_t>(archived));
+        }
+
+        // New region, with twice the room if the old one is full
+        std::uint64_t needed = latest.size() + (inOrder ? records.size() : 0);
+        std::uint64_t capacity = std::max<std::uint64_t>(INITIAL_CAPACITY, entry.regionCapacity);
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        std::uint64_t region = allocate(header, capacity * sizeof(RecordFrame));
+        std::vector<RecordFrame> frames;
+        frames.reserve(latest.size());
+        for (const HistoryRecord& record : latest) {
+            frames.push_back(toFrame(record));
+        }
+        if (!frames.empty() && !file.write(region, frames.data(), frames.size() * sizeof(RecordFrame))) {
+            return false;
+        }
+        header.garbage += std::uint64_t(entry.regionCapacity) * sizeof(RecordFrame);
+        entry.regionOffset = region;
+        entry.regionCapacity = static_cast<std::uint32_t>(capacity);
+        entry.recordCount = static_cast<std::uint32_t>(frames.size());
+        durable = true;
+    }
+
+    if (inOrder) {
+        std::vector<RecordFrame> frames;
+        frames.reserve(records.size());
+        for (const HistoryRecord& record : records) {
+            frames.push_back(toFrame(record));
+            entry.stats.add(record);
+        }
+        if (!file.write(entry.regionOffset + std::uint64_t(entry.recordCount) * sizeof(RecordFrame),
+                        frames.data(), frames.size() * sizeof(RecordFrame))) {
+            return false;
+        }
+        entry.recordCount += static_cast<std::uint32_t>(frames.size());
+    }
+
+    // Unsynced appends are batched up to a checkpoint
+    if (entry.recordCount - std::min(entry.durableCount, entry.recordCount) >= CHECKPOINT_RECORDS) {
+        durable = true;
+    }
+    if (durable) {
+        entry.durableCount = entry.recordCount;
+    }
+
+    // Data, then the header covering it, then the entry pointing to it
+    if (!file.barrier(durable) || !writeHeader(file, header) || !file.barrier(durable) ||
+        !writeEntry(file, header, place.slot, entry) || !file.barrier(durable)) {
+        return false;
+    }
+
+    if (updated != nullptr) {
+        *updated = entry.stats;
+    }
+
+    // Merged games can change any of the latest ones: read them again on next use
+    if (inOrder) {
+        cache.append(username, entry.stats, std::size_t(entry.archivedCount) + entry.recordCount, records);
+        cached.stored = true;
+    }
+
+    // Moved regions and archives are left behind; reclaim them once they
+    // are half of the shard
+    if (header.fileEnd >= VACUUM_AFTER && header.garbage * 2 > header.fileEnd) {
+        vacuum(file, path, header);
+    }
+    return true;
+}
+
+HistoryReader HistoryStore::open(const std::string& username) const {
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+    return openLocked(username, hash);
+}
+
+bool HistoryStore::stats(const std::string& username, HistoryStats& stats) const {
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+    return statsLocked(username, hash, stats);
+}
+
+HistorySnapshot HistoryStore::snapshot(const std::string& username) const {
+    HistorySnapshot snapshot;
+    if (cache.lookup(username, snapshot)) {
+        return snapshot;
+    }
+
+    // Filled under the shard lock, so no append can slip in between the
+    // read and the insert and be missing from the cached copy
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+    HistoryReader games = openLocked(username, hash);
+    statsLocked(username, hash, snapshot.stats);
+    snapshot.count = games.size();
+    std::size_t first = games.size() - std::min(games.size(), cache.recentGames());
+    snapshot.latest.reserve(games.size() - first);
+    for (std::size_t i = first; i < games.size(); ++i) {
+        snapshot.latest.push_back(games.record(i));
+    }
+    cache.insert(username, snapshot);
+    return snapshot;
+}
+
+HistoryReader HistoryStore::openLocked(const std::string& username, std::uint64_t hash) const {
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    ShardHeader header;
+    Probe place;
+    if (!file->open(shardFile(static_cast<int>(hash % SHARD_COUNT))) || !loadHeader(mappedReader(*file), header) ||
+        !probe(mappedReader(*file), header, username, hash, place) || !place.found) {
+        return HistoryReader();
+    }
+
+    // Bytes in use are never rewritten, so the snapshot stays valid; a
+    // damaged tail is cut off (and truncated by the next append)
+    const UserEntry& entry = place.entry;
+    std::uint32_t count = intactRecords(mappedReader(*file), entry);
+    if (entry.archiveOffset > file->size() || entry.archiveSize > file->size() - entry.archiveOffset) {
+        return HistoryReader();
+    }
+    const unsigned char* records = file->data() + entry.regionOffset + offsetof(RecordFrame, record);
+    const unsigned char* archive = file->data() + entry.archiveOffset;
+    return HistoryReader(std::move(file), records, count, sizeof(RecordFrame), archive, entry.archiveSize);
+}
+
+bool HistoryStore::statsLocked(const std::string& username, std::uint64_t hash, HistoryStats& stats) const {
+    stats = HistoryStats();
+    MappedFile file;
+    ShardHeader header;
+    Probe place;
+    if (!file.open(shardFile(static_cast<int>(hash % SHARD_COUNT))) || !loadHeader(mappedReader(file), header) ||
+        !probe(mappedReader(file), header, username, hash, place) || !place.found) {
+        return false;
+    }
+
+    // After a crash the stored stats may count records that were lost
+    std::uint32_t intact = intactRecords(mappedReader(file), place.entry);
+    if (intact < place.entry.recordCount) {
+        std::vector<HistoryRecord> kept;
+        if (!loadAll(mappedReader(file), place.entry, intact, kept)) {
+            return false;
+        }
+        stats = countStats(kept);
+        return true;
+    }
+    stats = place.entry.stats;
+    return true;
+}
+
+bool HistoryStore::verify(const std::string& username) const {
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+
+    MappedFile file;
+    ShardHeader header;
+    Probe place;
+    if (!file.open(shardFile(shard))) {
+        return true; // Nobody in this shard has played yet
+    }
+    if (!loadHeader(mappedReader(file), header) || !probe(mappedReader(file), header, username, hash, place)) {
+        return false;
+    }
+    if (!place.found) {
+        return true;
+    }
+    std::vector<HistoryRecord> archived;
+    return loadAll(mappedReader(file), place.entry, 0, archived) &&
+           intactRecords(mappedReader(file), place.entry, true) == place.entry.recordCount;
+}
+
+bool HistoryStore::remove(const std::string& username) {
+    std::uint64_t hash = nameHash(username);
+    int shard = static_cast<int>(hash % SHARD_COUNT);
+    std::lock_guard<std::mutex> lock(shardLocks[shard]);
+    cache.erase(username);
+
+    ShardFile file;
+    ShardHeader header;
+    Probe place;
+    if (!file.open(shardFile(shard)) || !loadHeader(file.reader(), header) ||
+        !probe(file.reader(), header, username, hash, place) || !place.found) {
+        return false;
+    }
+
+    UserEntry entry = place.entry;
+    entry.state = SLOT_DELETED;
+    header.garbage += std::uint64_t(entry.regionCapacity) * sizeof(RecordFrame) + entry.archiveCapacity + entry.nameLength;
+    header.userCount--;
+    return writeEntry(file, header, place.slot, entry) && file.barrier(true) &&
+           writeHeader(file, header) && file.barrier(true);
+}
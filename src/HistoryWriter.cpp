@@ -0,0 +1,130 @@
+// HistoryWriter.cpp
+#include "HistoryWriter.h"
+#include "HistoryStore.h"
+#include <algorithm>
+#include <iterator>    // For make_move_iterator
+#include <map>
+#include <thread>      // For sleep_for
+#include <utility>
+#include <vector>
+
+HistoryWriter::HistoryWriter() : HistoryWriter(Options()) {}
+
+HistoryWriter::HistoryWriter(const Options& options)
+    : options(options), submittedCount(0), committedCount(0), failedCount(0), batches(0), stopping(false) {
+    this->options.queueCapacity = std::max<std::size_t>(1, options.queueCapacity);
+    this->options.maxBatch = std::max<std::size_t>(1, options.maxBatch);
+    this->options.maxAttempts = std::max(1, options.maxAttempts);
+    worker = std::thread(&HistoryWriter::workerLoop, this);
+}
+
+HistoryWriter::~HistoryWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    worker.join();
+}
+
+void HistoryWriter::submit(const History& history, const HistoryRecord& record) {
+    Pending pending{history, record};
+    pending.history.writer = nullptr; // The worker stores in place
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        spaceFree.wait(lock, [this] { return queue.size() < options.queueCapacity; });
+        queue.push_back(std::move(pending));
+        submittedCount++;
+    }
+    workReady.notify_one();
+}
+
+bool HistoryWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::uint64_t target = submittedCount;
+    std::uint64_t failedBefore = failedCount;
+    committed.wait(lock, [this, target] { return committedCount >= target; });
+    return failedCount == failedBefore;
+}
+
+std::uint64_t HistoryWriter::batchesCommitted() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return batches;
+}
+
+std::uint64_t HistoryWriter::failedResults() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failedCount;
+}
+
+void HistoryWriter::workerLoop() {
+    for (;;) {
+        std::deque<Pending> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return; // Stopping and everything is stored
+            }
+
+            // Everything queued while the last batch was written goes together
+            std::size_t take = std::min(queue.size(), options.maxBatch);
+            batch.insert(batch.end(), std::make_move_iterator(queue.begin()),
+                         std::make_move_iterator(queue.begin() + static_cast<std::ptrdiff_t>(take)));
+            queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(take));
+        }
+        spaceFree.notify_all();
+
+        std::size_t failed = commitBatch(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            committedCount += batch.size();
+            failedCount += failed;
+            batches++;
+        }
+        committed.notify_all();
+    }
+}
+
+std::size_t HistoryWriter::commitBatch(std::deque<Pending>& batch) {
+    // One append per user and store, keeping each user's games in submission order
+    std::vector<std::size_t> owners;                  // Index in 'batch' of each user's first result
+    std::vector<std::vector<HistoryRecord>> records;  // Records per user
+    std::map<std::pair<const HistoryStore*, std::string>, std::size_t> userIndex;
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const History& history = batch[i].history;
+        auto inserted = userIndex.emplace(std::make_pair(history.store, history.username), owners.size());
+        if (inserted.second) {
+            owners.push_back(i);
+            records.emplace_back();
+        }
+        records[inserted.first->second].push_back(batch[i].record);
+    }
+
+    // A failed append stores none of its records, so it can simply be retried
+    std::size_t failed = 0;
+    for (std::size_t user = 0; user < owners.size(); ++user) {
+        bool stored = false;
+        for (int attempt = 0; attempt < options.maxAttempts && !stored; ++attempt) {
+            if (attempt > 0) {
+                std::this_thread::sleep_for(options.retryDelay);
+            }
+            stored = batch[owners[user]].history.commit(records[user], options.syncEachBatch);
+        }
+        if (!stored) {
+            failed += records[user].size();
+        }
+    }
+    return failed;
+}
+
+HistoryWriter& HistoryWriter::shared() {
+    // Statics are destroyed in reverse order of construction: building the
+    // store (and its board) first keeps it alive while the destructor drains
+    HistoryStore::shared().leaderboard();
+    static HistoryWriter writer;
+    return writer;
+}
@@ -0,0 +1,348 @@
+// Leaderboard.cpp
+#include "Leaderboard.h"
+#include "Crc32c.h"
+#include <algorithm>   // For std::min
+#include <cstdio>      // For rename / remove
+#include <cstring>     // For memcpy / memcmp
+#include <iterator>    // For istreambuf_iterator
+
+namespace {
+    // Log file: a header, then one record (and the name after it) per update
+    struct LogHeader {
+        char magic[4];               // "TTTL"
+        std::uint32_t version;
+    };
+
+    struct LogRecord {
+        std::uint32_t crc;           // CRC-32C of the rest of the record and the name
+        std::uint16_t nameLength;
+        std::uint16_t removed;       // 1 = the user left the board
+        OutcomeTotals totals;        // The user's totals from now on
+    };
+
+    static_assert(sizeof(LogHeader) == 8, "leaderboard log header must stay 8 bytes");
+    static_assert(sizeof(LogRecord) == 24, "leaderboard log record must stay 24 bytes");
+
+    const char LOG_MAGIC[4] = {'T', 'T', 'T', 'L'};
+    const std::uint32_t LOG_VERSION = 1;
+
+    // Superseded records tolerated before the log is rewritten
+    const std::size_t COMPACT_AFTER = 4096;
+
+    std::uint32_t points(const OutcomeTotals& totals) {
+        return totals.wins * 2 + totals.draws;
+    }
+
+    std::uint32_t recordCrc(const LogRecord& record, const char* name) {
+        std::uint32_t crc = Crc32c::compute(reinterpret_cast<const unsigned char*>(&record) + sizeof(record.crc),
+                                            sizeof(record) - sizeof(record.crc));
+        return Crc32c::extend(crc, name, record.nameLength);
+    }
+}
+
+std::uint32_t LeaderboardEntry::points() const {
+    return ::points(totals);
+}
+
+Leaderboard::Leaderboard(const std::string& path)
+    : path(path), head(), userCount(0), random(20240615u), logRecords(0) {
+    head.level = MAX_LEVEL;
+    clearLinks();
+    load();
+}
+
+Leaderboard::~Leaderboard() = default;
+
+const std::string& Leaderboard::getPath() const {
+    return path;
+}
+
+void Leaderboard::clearLinks() {
+    for (int i = 0; i < MAX_LEVEL; ++i) {
+        head.next[i] = nullptr;
+        head.width[i] = 1;
+    }
+    userCount = 0;
+}
+
+bool Leaderboard::ranksBefore(const Node& a, const Node& b) {
+    std::uint32_t pointsA = ::points(a.totals), pointsB = ::points(b.totals);
+    if (pointsA != pointsB) return pointsA > pointsB;
+    if (a.totals.wins != b.totals.wins) return a.totals.wins > b.totals.wins;
+    if (a.totals.games != b.totals.games) return a.totals.games < b.totals.games;
+    return a.username < b.username;
+}
+
+int Leaderboard::randomLevel() {
+    // Each level holds a quarter of the one below
+    int level = 1;
+    while (level < MAX_LEVEL && (random() & 3u) == 0) {
+        ++level;
+    }
+    return level;
+}
+
+void Leaderboard::link(Node* node) {
+    // The last node before 'node' on every level, and how far apart they are
+    Node* chain[MAX_LEVEL];
+    std::size_t steps[MAX_LEVEL];
+    Node* x = &head;
+    for (int i = MAX_LEVEL - 1; i >= 0; --i) {
+        steps[i] = 0;
+        while (x->next[i] != nullptr && ranksBefore(*x->next[i], *node)) {
+            steps[i] += x->width[i];
+            x = x->next[i];
+        }
+        chain[i] = x;
+    }
+
+    std::size_t distance = 0;  // From chain[i] to chain[0]
+    for (int i = 0; i < node->level; ++i) {
+        node->next[i] = chain[i]->next[i];
+        chain[i]->next[i] = node;
+        node->width[i] = chain[i]->width[i] - distance;
+        chain[i]->width[i] = distance + 1;
+        distance += steps[i];
+    }
+    for (int i = node->level; i < MAX_LEVEL; ++i) {
+        chain[i]->width[i]++;
+    }
+    userCount++;
+}
+
+void Leaderboard::unlink(Node* node) {
+    Node* chain[MAX_LEVEL];
+    Node* x = &head;
+    for (int i = MAX_LEVEL - 1; i >= 0; --i) {
+        while (x->next[i] != nullptr && ranksBefore(*x->next[i], *node)) {
+            x = x->next[i];
+        }
+        chain[i] = x;
+    }
+
+    for (int i = 0; i < node->level; ++i) {
+        chain[i]->width[i] += node->width[i] - 1;
+        chain[i]->next[i] = node->next[i];
+    }
+    for (int i = node->level; i < MAX_LEVEL; ++i) {
+        chain[i]->width[i]--;
+    }
+    userCount--;
+}
+
+std::size_t Leaderboard::rankOf(const Node* node) const {
+    std::size_t position = 0;
+    const Node* x = &head;
+    for (int i = MAX_LEVEL - 1; i >= 0; --i) {
+        while (x->next[i] != nullptr && ranksBefore(*x->next[i], *node)) {
+            position += x->width[i];
+            x = x->next[i];
+        }
+    }
+    return position + 1;
+}
+
+void Leaderboard::update(const std::string& username, const OutcomeTotals& totals) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = users.find(username);
+    if (totals.games == 0) {
+        if (it != users.end()) {
+            unlink(it->second.get());
+            users.erase(it);
+            logUpdate(username, totals, true);
+        }
+        return;
+    }
+
+    if (it == users.end()) {
+        std::unique_ptr<Node> node(new Node());
+        node->username = username;
+        node->level = randomLevel();
+        it = users.emplace(username, std::move(node)).first;
+    } else {
+        const OutcomeTotals& old = it->second->totals;
+        if (old.games == totals.games && old.wins == totals.wins && old.losses == totals.losses &&
+            old.draws == totals.draws) {
+            return;
+        }
+        unlink(it->second.get());
+    }
+    it->second->totals = totals;
+    link(it->second.get());
+    logUpdate(username, totals, false);
+}
+
+bool Leaderboard::remove(const std::string& username) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return false;
+    }
+    unlink(it->second.get());
+    users.erase(it);
+    logUpdate(username, OutcomeTotals(), true);
+    return true;
+}
+
+void Leaderboard::assign(const std::vector<LeaderboardEntry>& entries) {
+    std::lock_guard<std::mutex> lock(mutex);
+    clearLinks();
+    users.clear();
+    for (const LeaderboardEntry& entry : entries) {
+        if (entry.totals.games == 0 || users.count(entry.username) != 0) continue;
+        std::unique_ptr<Node> node(new Node());
+        node->username = entry.username;
+        node->totals = entry.totals;
+        node->level = randomLevel();
+        link(node.get());
+        users.emplace(entry.username, std::move(node));
+    }
+    compact();
+}
+
+std::vector<LeaderboardEntry> Leaderboard::top(std::size_t count) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<LeaderboardEntry> entries;
+    entries.reserve(std::min(count, userCount));
+    for (const Node* x = head.next[0]; x != nullptr && entries.size() < count; x = x->next[0]) {
+        LeaderboardEntry entry;
+        entry.username = x->username;
+        entry.totals = x->totals;
+        entry.rank = entries.size() + 1;
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+bool Leaderboard::find(const std::string& username, LeaderboardEntry& entry) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = users.find(username);
+    if (it == users.end()) {
+        return false;
+    }
+    entry.username = username;
+    entry.totals = it->second->totals;
+    entry.rank = rankOf(it->second.get());
+    return true;
+}
+
+std::size_t Leaderboard::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return userCount;
+}
+
+void Leaderboard::load() {
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // Replay up to the first damaged record (a torn last append)
+    bool whole = bytes.size() >= sizeof(LogHeader) && std::memcmp(bytes.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) == 0;
+    LogHeader header;
+    if (whole) {
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        whole = header.version == LOG_VERSION;
+    }
+    std::size_t position = sizeof(LogHeader);
+    while (whole && position < bytes.size()) {
+        LogRecord record;
+        if (bytes.size() - position < sizeof(record)) {
+            whole = false;
+            break;
+        }
+        std::memcpy(&record, bytes.data() + position, sizeof(record));
+        const char* name = bytes.data() + position + sizeof(record);
+        if (record.nameLength > bytes.size() - position - sizeof(record) || recordCrc(record, name) != record.crc) {
+            whole = false;
+            break;
+        }
+        position += sizeof(record) + record.nameLength;
+        logRecords++;
+
+        std::string username(name, record.nameLength);
+        auto it = users.find(username);
+        if (it != users.end()) {
+            unlink(it->second.get());
+            if (record.removed != 0 || record.totals.games == 0) {
+                users.erase(it);
+                continue;
+            }
+        } else {
+            if (record.removed != 0 || record.totals.games == 0) continue;
+            std::unique_ptr<Node> node(new Node());
+            node->username = username;
+            node->level = randomLevel();
+            it = users.emplace(username, std::move(node)).first;
+        }
+        it->second->totals = record.totals;
+        link(it->second.get());
+    }
+
+    // A missing, damaged or mostly superseded log is written afresh
+    if (!whole || (logRecords > COMPACT_AFTER && logRecords > userCount * 2)) {
+        compact();
+    } else {
+        log.open(path, std::ios::binary | std::ios::app);
+    }
+}
+
+void Leaderboard::writeRecord(std::ostream& out, const std::string& username, const OutcomeTotals& totals,
+                              bool removed) {
+    LogRecord record;
+    record.nameLength = static_cast<std::uint16_t>(username.size());
+    record.removed = removed ? 1 : 0;
+    record.totals = totals;
+    record.crc = recordCrc(record, username.data());
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    out.write(username.data(), static_cast<std::streamsize>(username.size()));
+}
+
+void Leaderboard::logUpdate(const std::string& username, const OutcomeTotals& totals, bool removed) {
+    if (username.size() > 0xFFFF) {
+        return; // Kept in memory only
+    }
+    writeRecord(log, username, totals, removed);
+    log.flush();
+    logRecords++;
+    if (logRecords > COMPACT_AFTER && logRecords > userCount * 2) {
+        compact();
+    }
+}
+
+void Leaderboard::compact() {
+    // Written beside the log and renamed over it, so a crash keeps one of them whole
+    std::string temporary = path + ".tmp";
+    std::size_t written = 0;
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        LogHeader header;
+        std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        header.version = LOG_VERSION;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const Node* x = head.next[0]; x != nullptr; x = x->next[0]) {
+            if (x->username.size() > 0xFFFF) continue;
+            writeRecord(out, x->username, x->totals, false);
+            written++;
+        }
+        if (!out.good()) {
+            out.close();
+            std::remove(temporary.c_str());
+            if (!log.is_open()) {
+                log.open(path, std::ios::binary | std::ios::app);
+            }
+            return;
+        }
+    }
+
+    log.close();
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        // Replacing an existing file fails on Windows
+        std::remove(path.c_str());
+        std::rename(temporary.c_str(), path.c_str());
+    }
+    log.clear();
+    log.open(path, std::ios::binary | std::ios::app);
+    logRecords = written;
+}
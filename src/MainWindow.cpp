@@ -1,21 +1,50 @@
 #include "MainWindow.h"
 #include "GameModeWindow.h"
+#include "HistoryCache.h"
+#include "HistoryStore.h"
+#include "HistoryWriter.h"
+#include "Leaderboard.h"
 #include <QGridLayout>
 #include <QMessageBox>
-#include <QDateTime>
 #include <QTimer>
 #include <QApplication>
 #include <QStyle>
+#include <QDebug>
 
-MainWindow::MainWindow(const QString& username, QWidget* parent)
-    : QMainWindow(parent), ai(Player::O), user(username), history(username.toStdString()),
-    playerWins(0), aiWins(0), draws(0) {
+MainWindow::MainWindow(const QString& username, Difficulty difficulty,
+                       const TimeControl& timeControl, QWidget* parent)
+    : QMainWindow(parent), difficulty(difficulty), timeControl(timeControl), clock(timeControl),
+    ai(Player::O, difficulty), user(username),
+    history(username.toStdString(), &HistoryWriter::shared()), playerWins(0), aiWins(0), draws(0) {
 
-    setWindowTitle("Tic Tac Toe - Playing as " + username);
+    setWindowTitle("Tic Tac Toe - Playing as " + username + " vs " +
+                   QString::fromStdString(AI::difficultyName(difficulty)) + " AI");
     setFixedSize(600, 700);
+
+    // Perfect play starts from the precomputed files shipped next to the
+    // executable; the tablebase covers every position, the book the openings
+    if (difficulty == Difficulty::HARD) {
+        QString dir = QApplication::applicationDirPath();
+        if (tablebase.open((dir + "/tablebase.bin").toStdString())) {
+            ai.setTablebase(&tablebase);
+        }
+        if (openingBook.open((dir + "/opening_book.bin").toStdString())) {
+            ai.setOpeningBook(&openingBook);
+        }
+    }
+
     setupUI();
     applyStyles();
     updateBoard();
+
+    // Timed games: the display refreshes and watches for flag fall 10x a second
+    clockTimer = new QTimer(this);
+    connect(clockTimer, &QTimer::timeout, this, &MainWindow::updateClock);
+    if (timeControl.isTimed()) {
+        clock.start(Player::X);
+        clockTimer->start(100);
+    }
+    updateClock();
 }
 
 void MainWindow::setupUI()
@@ -46,8 +75,14 @@ void MainWindow::setupUI()
     statusLabel->setObjectName("statusLabel");
     statusLabel->setAlignment(Qt::AlignCenter);
 
+    // Remaining time of both sides, only shown in timed games
+    clockLabel = new QLabel();
+    clockLabel->setObjectName("clockLabel");
+    clockLabel->setVisible(timeControl.isTimed());
+
     topControlLayout->addWidget(playerLabel);
     topControlLayout->addStretch();
+    topControlLayout->addWidget(clockLabel);
     topControlLayout->addWidget(statusLabel);
     topControlLayout->setContentsMargins(0, 0, 0, 5);
     // Score display
@@ -66,12 +101,17 @@ void MainWindow::setupUI()
     historyBtn->setObjectName("controlButton");
     historyBtn->setFixedHeight(35);
 
+    leaderboardBtn = new QPushButton("🏆 LEADERBOARD");
+    leaderboardBtn->setObjectName("controlButton");
+    leaderboardBtn->setFixedHeight(35);
+
     backBtn = new QPushButton("← BACK");
     backBtn->setObjectName("backButton");
     backBtn->setFixedHeight(35);
 
     buttonLayout->addWidget(newGameBtn);
     buttonLayout->addWidget(historyBtn);
+    buttonLayout->addWidget(leaderboardBtn);
     buttonLayout->addStretch();
     buttonLayout->addWidget(backBtn);
 
@@ -105,6 +145,7 @@ void MainWindow::setupUI()
     // Connect signals
     connect(newGameBtn, &QPushButton::clicked, this, &MainWindow::newGame);
     connect(historyBtn, &QPushButton::clicked, this, &MainWindow::showHistory);
+    connect(leaderboardBtn, &QPushButton::clicked, this, &MainWindow::showLeaderboard);
     connect(backBtn, &QPushButton::clicked, this, &MainWindow::goBack);
 }
 
@@ -144,6 +185,13 @@ void MainWindow::applyStyles()
             min-width: 120px;
         }
 
+        #clockLabel {
+            font-size: 14px;
+            font-weight: bold;
+            color: #2c3e50;
+            font-family: 'Consolas', 'Courier New', monospace;
+        }
+
         #scoreLabel {
             font-size: 14px;
             color: #7f8c8d;
@@ -230,8 +278,15 @@ void MainWindow::handleCellClick() {
         }
     }
 
+    // A move after the flag fell does not count
+    if (clock.flagged() != Player::NONE) {
+        updateClock();
+        return;
+    }
+
     // Make player move
     if (!game.makeMove(r, c)) return;
+    clock.press();
 
     updateBoard();
     statusLabel->setText("AI thinking...");
@@ -241,6 +296,7 @@ void MainWindow::handleCellClick() {
 
     // Check for game end after player move
     if (game.getWinner() != Player::NONE || game.isDraw()) {
+        clock.stop();
         QTimer::singleShot(500, [this]() {
             handleGameEnd();
         });
@@ -250,11 +306,20 @@ void MainWindow::handleCellClick() {
     // Disable board during AI turn
     enableBoard(false);
 
-    // AI makes move after short delay
-    QTimer::singleShot(800, [this]() {
-        auto move = ai.findBestMove(game);
+    // AI makes move after short delay; on the clock the delay is its own time
+    QTimer::singleShot(timeControl.isTimed() ? 100 : 800, [this]() {
+        if (game.getWinner() != Player::NONE) return; // Flag fell while waiting
+
+        auto move = timeControl.isTimed() ? ai.findBestMove(game, clock) : ai.findBestMove(game);
+        qInfo().noquote() << "AI search:" << QString::fromStdString(ai.getLastSearchStats().toString());
+        if (!clock.press()) {
+            game.flagFall(Player::O); // Search overran the clock
+            handleGameEnd();
+            return;
+        }
         game.makeMove(move.first, move.second);
         updateBoard();
+        updateClock();
 
         statusLabel->setText("Your turn!");
         statusLabel->setStyleSheet("color: #e74c3c; background: rgba(231, 76, 60, 0.1);");
@@ -269,6 +334,8 @@ void MainWindow::handleCellClick() {
 
 void MainWindow::handleGameEnd() {
     enableBoard(false);
+    clock.stop();
+    updateClock();
 
     QString result;
     if (game.getWinner() == Player::X) {
@@ -288,6 +355,10 @@ void MainWindow::handleGameEnd() {
         statusLabel->setStyleSheet("color: #f39c12; background: rgba(243, 156, 18, 0.1);");
     }
 
+    if (game.getFlagged() != Player::NONE) {
+        result += " (on time)";
+    }
+
     // Update score display
     scoreLabel->setText(QString("Wins: %1 | AI: %2 | Draws: %3")
                             .arg(playerWins).arg(aiWins).arg(draws));
@@ -329,6 +400,11 @@ void MainWindow::enableBoard(bool enabled) {
 
 void MainWindow::newGame() {
     game.reset();
+    clock = GameClock(timeControl);
+    if (timeControl.isTimed()) {
+        clock.start(Player::X);
+    }
+    updateClock();
     updateBoard();
     enableBoard(true);
     statusLabel->setText("Your turn!");
@@ -344,9 +420,42 @@ void MainWindow::newGame() {
     }
 }
 
+void MainWindow::updateClock() {
+    if (!timeControl.isTimed()) return;
+
+    auto now = GameClock::Clock::now();
+    clockLabel->setText(QString("⏱ You %1 | AI %2")
+                            .arg(QString::fromStdString(GameClock::format(clock.remaining(Player::X, now))))
+                            .arg(QString::fromStdString(GameClock::format(clock.remaining(Player::O, now)))));
+
+    // Flag fall ends a game that is still running
+    Player flagged = clock.flagged(now);
+    if (flagged != Player::NONE && game.getWinner() == Player::NONE && !game.isDraw()) {
+        game.flagFall(flagged);
+        handleGameEnd();
+    }
+}
+
 void MainWindow::showHistory() {
-    auto gameHistory = history.loadHistory();
-    QString historyText = "Game History:\n\n";
+    // Only the latest screenful is shown, however long the history is; it
+    // comes from the store's cache, shared with every other window
+    const std::size_t shown = 20;
+    HistorySnapshot snapshot = history.snapshot();
+    auto gameHistory = history.loadLatest(shown);
+    std::size_t total = snapshot.count;
+    QString historyText = total > shown
+        ? QString("Game History (last %1 of %2 games):\n\n").arg(shown).arg(total)
+        : QString("Game History:\n\n");
+
+    // Lifetime summary, kept up to date as games are saved
+    const HistoryStats& stats = snapshot.stats;
+    if (stats.total.games > 0) {
+        historyText = QString("Lifetime: %1 wins, %2 losses, %3 draws (%4% won)\n"
+                              "Best win streak: %5\n\n")
+                          .arg(stats.total.wins).arg(stats.total.losses).arg(stats.total.draws)
+                          .arg(qRound(100.0 * stats.total.winRate()))
+                          .arg(stats.bestWinStreak) + historyText;
+    }
 
     if (gameHistory.empty()) {
         historyText += "No games played yet!";
@@ -376,10 +485,47 @@ void MainWindow::showAbout() {
     QMessageBox::about(this, "About",
                        "Advanced Tic Tac Toe\n\n"
                        "Player: " + user + "\n"
-                                    "Playing against AI\n\n"
+                                    "Playing against " + QString::fromStdString(AI::difficultyName(difficulty)) + " AI\n\n"
                                     "Enjoy the game!");
 }
 
+void MainWindow::showLeaderboard() {
+    // Kept ranked as games are saved, so this reads the top without sorting
+    const std::size_t shown = 10;
+    Leaderboard& board = HistoryStore::shared().leaderboard();
+    auto best = board.top(shown);
+    QString boardText = QString("Leaderboard (%1 players):\n\n").arg(board.size());
+
+    if (best.empty()) {
+        boardText += "No games played yet!";
+    }
+    for (const auto& entry : best) {
+        boardText += QString("%1. %2 - %3 points (%4 W / %5 D / %6 L)\n")
+                         .arg(entry.rank).arg(QString::fromStdString(entry.username)).arg(entry.points())
+                         .arg(entry.totals.wins).arg(entry.totals.draws).arg(entry.totals.losses);
+    }
+
+    // The player's own place when they are not in the top
+    LeaderboardEntry own;
+    if (board.find(user.toStdString(), own) && own.rank > shown) {
+        boardText += QString("\n...\n%1. %2 - %3 points\n").arg(own.rank).arg(user).arg(own.points());
+    }
+
+    QMessageBox msgBox;
+    msgBox.setWindowTitle("Leaderboard");
+    msgBox.setText(boardText);
+    msgBox.setStyleSheet(R"(
+        QMessageBox {
+            background: white;
+        }
+        QMessageBox QLabel {
+            color: #2c3e50;
+            font-size: 12px;
+        }
+    )");
+    msgBox.exec();
+}
+
 void MainWindow::goBack() {
     GameModeWindow *gameModeWindow = new GameModeWindow(user);
     gameModeWindow->show();
@@ -387,9 +533,9 @@ void MainWindow::goBack() {
 }
 
 void MainWindow::logResult(const QString& result) {
-    GameResult res;
-    res.date = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss").toStdString();
+    GameResult res;  // No date: stamped with the current time when saved
     res.result = result.toStdString();
+    res.mode = static_cast<HistoryMode>(static_cast<int>(HistoryMode::AI_EASY) + static_cast<int>(difficulty));
     history.saveResult(res);
 }
 
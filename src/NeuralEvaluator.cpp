@@ -0,0 +1,190 @@
+// NeuralEvaluator.cpp
+#include "NeuralEvaluator.h"
+#include "CpuFeatures.h"
+#include <algorithm>
+#include <cstring>     // For memcmp / memcpy
+#include <fstream>     // For the weights file
+
+#if defined(CPU_FEATURES_X86)
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Weights file: header followed by NeuralEvaluator::Weights
+    struct NetHeader {
+        char magic[4];              // "TTTN"
+        std::uint32_t version;
+        std::uint32_t inputs;       // Layer sizes, guard against a different build
+        std::uint32_t hidden;
+    };
+
+    const char NET_MAGIC[4] = {'T', 'T', 'T', 'N'};
+    const std::uint32_t NET_VERSION = 1;
+
+    // Feature of a mark seen from one side: own cells first, then the opponent's
+    int featureOf(int perspective, Player player, int cell) {
+        bool own = (perspective == 0) == (player == Player::X);
+        return own ? cell : cell + 9;
+    }
+
+    int clampScore(int score) {
+        return std::max(-NeuralEvaluator::MAX_SCORE, std::min(score, NeuralEvaluator::MAX_SCORE));
+    }
+}
+
+NeuralEvaluator::NeuralEvaluator() {}
+
+NeuralEvaluator::NeuralEvaluator(const Weights& weights) : net(weights) {}
+
+bool NeuralEvaluator::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    NetHeader header;
+    Weights weights;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, NET_MAGIC, sizeof(NET_MAGIC)) != 0 ||
+        header.version != NET_VERSION || header.inputs != INPUTS || header.hidden != HIDDEN) {
+        return false;
+    }
+    in.read(reinterpret_cast<char*>(&weights), sizeof(weights));
+    if (!in || in.peek() != std::ifstream::traits_type::eof()) {
+        return false; // Truncated, or trailing data from another format
+    }
+
+    net = weights;
+    return true;
+}
+
+bool NeuralEvaluator::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    NetHeader header;
+    std::memcpy(header.magic, NET_MAGIC, sizeof(NET_MAGIC));
+    header.version = NET_VERSION;
+    header.inputs = INPUTS;
+    header.hidden = HIDDEN;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(&net), sizeof(net));
+    return out.good();
+}
+
+const NeuralEvaluator::Weights& NeuralEvaluator::getWeights() const {
+    return net;
+}
+
+void NeuralEvaluator::setWeights(const Weights& weights) {
+    net = weights;
+}
+
+void NeuralEvaluator::refresh(Accumulator& accumulator, std::uint16_t xCells, std::uint16_t oCells) const {
+    for (int perspective = 0; perspective < 2; ++perspective) {
+        std::copy(net.hiddenBias.begin(), net.hiddenBias.end(), accumulator.values[perspective]);
+        for (int cell = 0; cell < 9; ++cell) {
+            if (xCells & (1u << cell)) {
+                applyFeature(accumulator.values[perspective], featureOf(perspective, Player::X, cell), 1);
+            }
+            if (oCells & (1u << cell)) {
+                applyFeature(accumulator.values[perspective], featureOf(perspective, Player::O, cell), 1);
+            }
+        }
+    }
+}
+
+void NeuralEvaluator::addMark(Accumulator& accumulator, Player player, int cell) const {
+    applyFeature(accumulator.values[0], featureOf(0, player, cell), 1);
+    applyFeature(accumulator.values[1], featureOf(1, player, cell), 1);
+}
+
+void NeuralEvaluator::removeMark(Accumulator& accumulator, Player player, int cell) const {
+    applyFeature(accumulator.values[0], featureOf(0, player, cell), -1);
+    applyFeature(accumulator.values[1], featureOf(1, player, cell), -1);
+}
+
+int NeuralEvaluator::evaluate(std::uint16_t mine, std::uint16_t theirs) const {
+    Accumulator accumulator;
+    refresh(accumulator, mine, theirs);
+    return evaluate(accumulator, Player::X);
+}
+
+int NeuralEvaluator::evaluateScalar(const Accumulator& accumulator, Player toMove) const {
+    const std::int16_t* values = accumulator.values[toMove == Player::X ? 0 : 1];
+    std::int32_t sum = net.outputBias;
+    for (int unit = 0; unit < HIDDEN; ++unit) {
+        int activation = std::max(0, std::min(static_cast<int>(values[unit]), ACTIVATION_MAX));
+        sum += activation * net.outputWeights[unit];
+    }
+    return clampScore(sum / OUTPUT_DIVISOR);
+}
+
+#if defined(CPU_FEATURES_X86)
+
+namespace {
+    // AVX2 kernels, called only when the CPU has it
+
+    CPU_TARGET("avx2") void applyRowAvx2(std::int16_t* values, const std::int16_t* row, int sign) {
+        for (int unit = 0; unit < NeuralEvaluator::HIDDEN; unit += 16) {
+            __m256i sum = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + unit));
+            __m256i weights = _mm256_load_si256(reinterpret_cast<const __m256i*>(row + unit));
+            sum = (sign > 0) ? _mm256_add_epi16(sum, weights) : _mm256_sub_epi16(sum, weights);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(values + unit), sum);
+        }
+    }
+
+    CPU_TARGET("avx2") std::int32_t outputSumAvx2(const std::int16_t* values, const std::int16_t* outputWeights) {
+        const __m256i low = _mm256_setzero_si256();
+        const __m256i high = _mm256_set1_epi16(NeuralEvaluator::ACTIVATION_MAX);
+
+        // Clipped ReLU, then products summed pairwise into 32-bit lanes
+        __m256i sum = _mm256_setzero_si256();
+        for (int unit = 0; unit < NeuralEvaluator::HIDDEN; unit += 16) {
+            __m256i activation = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + unit));
+            activation = _mm256_min_epi16(_mm256_max_epi16(activation, low), high);
+            __m256i weights = _mm256_load_si256(reinterpret_cast<const __m256i*>(outputWeights + unit));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(activation, weights));
+        }
+
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+}
+
+#endif
+
+void NeuralEvaluator::applyFeature(std::int16_t* values, int feature, int sign) const {
+    const std::int16_t* row = net.inputWeights.data() + feature * HIDDEN;
+#if defined(CPU_FEATURES_X86)
+    if (usesSimd()) {
+        applyRowAvx2(values, row, sign);
+        return;
+    }
+#endif
+    for (int unit = 0; unit < HIDDEN; ++unit) {
+        values[unit] = static_cast<std::int16_t>(values[unit] + sign * row[unit]);
+    }
+}
+
+int NeuralEvaluator::evaluate(const Accumulator& accumulator, Player toMove) const {
+#if defined(CPU_FEATURES_X86)
+    if (usesSimd()) {
+        const std::int16_t* values = accumulator.values[toMove == Player::X ? 0 : 1];
+        return clampScore((outputSumAvx2(values, net.outputWeights.data()) + net.outputBias) / OUTPUT_DIVISOR);
+    }
+#endif
+    return evaluateScalar(accumulator, toMove);
+}
+
+bool NeuralEvaluator::usesSimd() {
+#if defined(CPU_FEATURES_X86)
+    return CpuFeatures::hasAvx2();
+#else
+    return false;
+#endif
+}
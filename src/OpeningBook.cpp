@@ -0,0 +1,154 @@
+// OpeningBook.cpp
+#include "OpeningBook.h"
+#include "AI.h"
+#include "BoardKey.h"
+#include <algorithm>
+#include <cstring>     // For memcmp / memcpy
+#include <fstream>     // For writing the book file
+#include <set>
+
+namespace {
+    // File header, followed by entryCount BookEntry records sorted by key
+    struct BookHeader {
+        char magic[4];              // "TTTB"
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t entrySize;    // sizeof(BookEntry), guards against layout changes
+    };
+
+    const char BOOK_MAGIC[4] = {'T', 'T', 'T', 'B'};
+    const std::uint32_t BOOK_VERSION = 1;
+}
+
+OpeningBook::OpeningBook() : entries(nullptr), entryCount(0) {}
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+
+    // Validate the header before trusting the record area
+    BookHeader header;
+    if (file.size() < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 ||
+        header.version != BOOK_VERSION || header.entrySize != sizeof(BookEntry) ||
+        file.size() != sizeof(header) + header.entryCount * sizeof(BookEntry)) {
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const BookEntry*>(file.data() + sizeof(header));
+    entryCount = header.entryCount;
+    return true;
+}
+
+void OpeningBook::close() {
+    file.close();
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool OpeningBook::isOpen() const {
+    return file.isOpen() && entries != nullptr;
+}
+
+std::size_t OpeningBook::size() const {
+    return entryCount;
+}
+
+bool OpeningBook::probe(const Game& game, std::pair<int, int>& move) const {
+    if (entries == nullptr) {
+        return false;
+    }
+
+    int symmetry = 0;
+    std::uint32_t key = BoardKey::canonical(BoardKey::fromGame(game), symmetry);
+
+    const BookEntry* end = entries + entryCount;
+    const BookEntry* found = std::lower_bound(entries, end, key,
+        [](const BookEntry& entry, std::uint32_t value) { return entry.key < value; });
+    if (found == end || found->key != key || found->move > 8) {
+        return false;
+    }
+
+    // The stored move is for the canonical board; map it back onto this one
+    int cell = BoardKey::transformCell(found->move, BoardKey::inverseSymmetry(symmetry));
+    if (game.at(cell / 3, cell % 3) != Player::NONE) {
+        return false; // Corrupt entry, let the search handle the position
+    }
+    move = std::make_pair(cell / 3, cell % 3);
+    return true;
+}
+
+std::vector<BookEntry> OpeningBook::build(int plies) {
+    // Collect the canonical form of every non-terminal position up to 'plies' moves
+    std::set<std::uint32_t> positions;
+    std::vector<std::uint32_t> frontier = {0};
+
+    for (int ply = 0; ply <= plies && !frontier.empty(); ++ply) {
+        std::set<std::uint32_t> next;
+        for (std::uint32_t key : frontier) {
+            Game game = BoardKey::toGame(key);
+            if (game.getWinner() != Player::NONE || game.isDraw()) {
+                continue;
+            }
+            positions.insert(key);
+
+            for (const auto& move : game.getAvailableMoves()) {
+                Game child = game;
+                child.makeMove(move.first, move.second);
+                int symmetry = 0;
+                std::uint32_t childKey = BoardKey::canonical(BoardKey::fromGame(child), symmetry);
+                if (positions.count(childKey) == 0) {
+                    next.insert(childKey);
+                }
+            }
+        }
+        frontier.assign(next.begin(), next.end());
+    }
+
+    // Solve each one with a full-depth search for the side to move
+    std::vector<BookEntry> result;
+    for (std::uint32_t key : positions) {
+        Game game = BoardKey::toGame(key);
+        AI ai(game.getCurrentPlayer(), Difficulty::HARD);
+        auto analysis = ai.analyze(game);
+        if (analysis.empty()) {
+            continue;
+        }
+
+        const MoveAnalysis& best = analysis[0];
+        BookEntry entry;
+        entry.key = key;
+        entry.move = static_cast<std::uint8_t>(best.move.first * 3 + best.move.second);
+        entry.outcome = (best.outcome == MoveOutcome::WIN) ? 1 : (best.outcome == MoveOutcome::LOSS) ? -1 : 0;
+        entry.depth = static_cast<std::uint16_t>(ai.getLimits().maxDepth);
+        result.push_back(entry);
+    }
+    return result;
+}
+
+bool OpeningBook::write(const std::string& path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const BookEntry& a, const BookEntry& b) { return a.key < b.key; });
+
+    BookHeader header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = BOOK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    header.entrySize = sizeof(BookEntry);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(BookEntry)));
+    return static_cast<bool>(out);
+}
@@ -1,12 +1,17 @@
 #include "PlayerVsPlayerWindow.h"
 #include "GameModeWindow.h"
-#include <QDateTime>
+#include "HistoryCache.h"
+#include "HistoryStore.h"
+#include "HistoryWriter.h"
+#include "Leaderboard.h"
 #include <QInputDialog>
 #include <QTimer>
 #include <QStyle>
 
-PlayerVsPlayerWindow::PlayerVsPlayerWindow(const QString& username, QWidget* parent)
-    : QMainWindow(parent), user(username), history(username.toStdString()),
+PlayerVsPlayerWindow::PlayerVsPlayerWindow(const QString& username, const TimeControl& timeControl,
+                                           QWidget* parent)
+    : QMainWindow(parent), timeControl(timeControl), clock(timeControl),
+    user(username), history(username.toStdString(), &HistoryWriter::shared()),
     player1Wins(0), player2Wins(0), draws(0) {
 
     // Get second player name
@@ -27,6 +32,15 @@ PlayerVsPlayerWindow::PlayerVsPlayerWindow(const QString& username, QWidget* par
     applyStyles();
     updateBoard();
     updatePlayerTurn();
+
+    // Timed games: the display refreshes and watches for flag fall 10x a second
+    clockTimer = new QTimer(this);
+    connect(clockTimer, &QTimer::timeout, this, &PlayerVsPlayerWindow::updateClock);
+    if (timeControl.isTimed()) {
+        clock.start(Player::X);
+        clockTimer->start(100);
+    }
+    updateClock();
 }
 
 void PlayerVsPlayerWindow::setupUI()
@@ -41,7 +55,7 @@ void PlayerVsPlayerWindow::setupUI()
     // Control Frame
     controlFrame = new QFrame();
     controlFrame->setObjectName("controlFrame");
-    controlFrame->setFixedHeight(140);
+    controlFrame->setFixedHeight(timeControl.isTimed() ? 170 : 140);
 
     QVBoxLayout* controlLayout = new QVBoxLayout(controlFrame);
     controlLayout->setSpacing(10);
@@ -70,6 +84,12 @@ void PlayerVsPlayerWindow::setupUI()
     statusLabel->setObjectName("statusLabel");
     statusLabel->setAlignment(Qt::AlignCenter);
 
+    // Remaining time of both players, only shown in timed games
+    clockLabel = new QLabel();
+    clockLabel->setObjectName("clockLabel");
+    clockLabel->setAlignment(Qt::AlignCenter);
+    clockLabel->setVisible(timeControl.isTimed());
+
     // Score display
     scoreLabel = new QLabel(QString("%1: 0 | %2: 0 | Draws: 0").arg(player1Name).arg(player2Name));
     scoreLabel->setObjectName("scoreLabel");
@@ -86,17 +106,23 @@ void PlayerVsPlayerWindow::setupUI()
     historyBtn->setObjectName("controlButton");
     historyBtn->setFixedHeight(35);
 
+    leaderboardBtn = new QPushButton("🏆 LEADERBOARD");
+    leaderboardBtn->setObjectName("controlButton");
+    leaderboardBtn->setFixedHeight(35);
+
     backBtn = new QPushButton("← BACK");
     backBtn->setObjectName("backButton");
     backBtn->setFixedHeight(35);
 
     buttonLayout->addWidget(newGameBtn);
     buttonLayout->addWidget(historyBtn);
+    buttonLayout->addWidget(leaderboardBtn);
     buttonLayout->addStretch();
     buttonLayout->addWidget(backBtn);
 
     controlLayout->addLayout(playerInfoLayout);
     controlLayout->addWidget(statusLabel);
+    controlLayout->addWidget(clockLabel);
     controlLayout->addWidget(scoreLabel);
     controlLayout->addLayout(buttonLayout);
 
@@ -126,6 +152,7 @@ void PlayerVsPlayerWindow::setupUI()
     // Connect signals
     connect(newGameBtn, &QPushButton::clicked, this, &PlayerVsPlayerWindow::newGame);
     connect(historyBtn, &QPushButton::clicked, this, &PlayerVsPlayerWindow::showHistory);
+    connect(leaderboardBtn, &QPushButton::clicked, this, &PlayerVsPlayerWindow::showLeaderboard);
     connect(backBtn, &QPushButton::clicked, this, &PlayerVsPlayerWindow::goBack);
 }
 
@@ -173,6 +200,13 @@ void PlayerVsPlayerWindow::applyStyles()
             font-weight: 500;
         }
 
+        #clockLabel {
+            font-size: 14px;
+            font-weight: bold;
+            color: #2c3e50;
+            font-family: 'Consolas', 'Courier New', monospace;
+        }
+
         #scoreLabel {
             font-size: 14px;
             color: #7f8c8d;
@@ -259,10 +293,18 @@ void PlayerVsPlayerWindow::handleCellClick() {
         }
     }
 
+    // A move after the flag fell does not count
+    if (clock.flagged() != Player::NONE) {
+        updateClock();
+        return;
+    }
+
     // Make move
     if (!game.makeMove(r, c)) return;
+    clock.press();
 
     updateBoard();
+    updateClock();
 
     // Check for game end
     if (game.getWinner() != Player::NONE || game.isDraw()) {
@@ -274,6 +316,8 @@ void PlayerVsPlayerWindow::handleCellClick() {
 
 void PlayerVsPlayerWindow::handleGameEnd() {
     enableBoard(false);
+    clock.stop();
+    updateClock();
 
     QString result;
     QString winnerName;
@@ -300,6 +344,12 @@ void PlayerVsPlayerWindow::handleGameEnd() {
         currentPlayerLabel->setStyleSheet("color: #f39c12; background: rgba(243, 156, 18, 0.1);");
     }
 
+    if (game.getFlagged() != Player::NONE) {
+        result += " (on time)";
+        statusLabel->setText(QString("%1 ran out of time!")
+                                 .arg(game.getFlagged() == Player::X ? player1Name : player2Name));
+    }
+
     // Update score display
     scoreLabel->setText(QString("%1: %2 | %3: %4 | Draws: %5")
                             .arg(player1Name).arg(player1Wins)
@@ -357,6 +407,11 @@ void PlayerVsPlayerWindow::enableBoard(bool enabled) {
 
 void PlayerVsPlayerWindow::newGame() {
     game.reset();
+    clock = GameClock(timeControl);
+    if (timeControl.isTimed()) {
+        clock.start(Player::X);
+    }
+    updateClock();
     updateBoard();
     enableBoard(true);
     updatePlayerTurn();
@@ -373,9 +428,44 @@ void PlayerVsPlayerWindow::newGame() {
     statusLabel->setText("New game started! X goes first.");
 }
 
+void PlayerVsPlayerWindow::updateClock() {
+    if (!timeControl.isTimed()) return;
+
+    auto now = GameClock::Clock::now();
+    clockLabel->setText(QString("⏱ %1 %2 | %3 %4")
+                            .arg(player1Name)
+                            .arg(QString::fromStdString(GameClock::format(clock.remaining(Player::X, now))))
+                            .arg(player2Name)
+                            .arg(QString::fromStdString(GameClock::format(clock.remaining(Player::O, now)))));
+
+    // Flag fall ends a game that is still running
+    Player flagged = clock.flagged(now);
+    if (flagged != Player::NONE && game.getWinner() == Player::NONE && !game.isDraw()) {
+        game.flagFall(flagged);
+        handleGameEnd();
+    }
+}
+
 void PlayerVsPlayerWindow::showHistory() {
-    auto gameHistory = history.loadHistory();
-    QString historyText = "Game History:\n\n";
+    // Only the latest screenful is shown, however long the history is; it
+    // comes from the store's cache, shared with every other window
+    const std::size_t shown = 20;
+    HistorySnapshot snapshot = history.snapshot();
+    auto gameHistory = history.loadLatest(shown);
+    std::size_t total = snapshot.count;
+    QString historyText = total > shown
+        ? QString("Game History (last %1 of %2 games):\n\n").arg(shown).arg(total)
+        : QString("Game History:\n\n");
+
+    // Lifetime summary, kept up to date as games are saved
+    const HistoryStats& stats = snapshot.stats;
+    if (stats.total.games > 0) {
+        historyText = QString("Lifetime: %1 wins, %2 losses, %3 draws (%4% won)\n"
+                              "Best win streak: %5\n\n")
+                          .arg(stats.total.wins).arg(stats.total.losses).arg(stats.total.draws)
+                          .arg(qRound(100.0 * stats.total.winRate()))
+                          .arg(stats.bestWinStreak) + historyText;
+    }
 
     if (gameHistory.empty()) {
         historyText += "No games played yet!";
@@ -401,6 +491,43 @@ void PlayerVsPlayerWindow::showHistory() {
     msgBox.exec();
 }
 
+void PlayerVsPlayerWindow::showLeaderboard() {
+    // Kept ranked as games are saved, so this reads the top without sorting
+    const std::size_t shown = 10;
+    Leaderboard& board = HistoryStore::shared().leaderboard();
+    auto best = board.top(shown);
+    QString boardText = QString("Leaderboard (%1 players):\n\n").arg(board.size());
+
+    if (best.empty()) {
+        boardText += "No games played yet!";
+    }
+    for (const auto& entry : best) {
+        boardText += QString("%1. %2 - %3 points (%4 W / %5 D / %6 L)\n")
+                         .arg(entry.rank).arg(QString::fromStdString(entry.username)).arg(entry.points())
+                         .arg(entry.totals.wins).arg(entry.totals.draws).arg(entry.totals.losses);
+    }
+
+    // The player's own place when they are not in the top
+    LeaderboardEntry own;
+    if (board.find(user.toStdString(), own) && own.rank > shown) {
+        boardText += QString("\n...\n%1. %2 - %3 points\n").arg(own.rank).arg(user).arg(own.points());
+    }
+
+    QMessageBox msgBox;
+    msgBox.setWindowTitle("Leaderboard");
+    msgBox.setText(boardText);
+    msgBox.setStyleSheet(R"(
+        QMessageBox {
+            background: white;
+        }
+        QMessageBox QLabel {
+            color: #2c3e50;
+            font-size: 12px;
+        }
+    )");
+    msgBox.exec();
+}
+
 void PlayerVsPlayerWindow::goBack() {
     GameModeWindow *gameModeWindow = new GameModeWindow(user);
     gameModeWindow->show();
@@ -408,9 +535,10 @@ void PlayerVsPlayerWindow::goBack() {
 }
 
 void PlayerVsPlayerWindow::logResult(const QString& result) {
-    GameResult res;
-    res.date = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss").toStdString();
+    GameResult res;  // No date: stamped with the current time when saved
     res.result = result.toStdString();
+    res.mode = HistoryMode::PLAYER;
+    res.opponent = History::opponentId(player2Name.toStdString());
     history.saveResult(res);
 }
 
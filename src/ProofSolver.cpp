@@ -0,0 +1,202 @@
+// ProofSolver.cpp
+#include "ProofSolver.h"
+#include "BoardKey.h"
+#include <algorithm>
+
+namespace {
+    std::uint32_t addCapped(std::uint32_t a, std::uint32_t b, std::uint32_t cap) {
+        return (a >= cap || b >= cap || a + b >= cap) ? cap : a + b;
+    }
+}
+
+ProofSolver::ProofSolver(std::size_t tableEntries, std::uint64_t maxNodes)
+    : maxNodes(maxNodes), nodeCount(0), aborted(false), attacker(Player::X), drawIsSuccess(false) {
+    std::size_t size = 1;
+    while (size < tableEntries) {
+        size <<= 1;
+    }
+    table.assign(size, Entry());
+    mask = size - 1;
+}
+
+void ProofSolver::lookup(std::uint32_t key, std::uint32_t& pn, std::uint32_t& dn) const {
+    const Entry& entry = table[(key * 2654435769u >> 8) & mask];
+    if (entry.work > 0 && entry.key == key) {
+        pn = entry.pn;
+        dn = entry.dn;
+    } else {
+        pn = 1;
+        dn = 1;
+    }
+}
+
+void ProofSolver::store(std::uint32_t key, std::uint32_t pn, std::uint32_t dn, std::uint64_t work) {
+    Entry& entry = table[(key * 2654435769u >> 8) & mask];
+    std::uint32_t cost = static_cast<std::uint32_t>(std::min<std::uint64_t>(work, INF)) + 1;
+
+    // Keep whichever result took more effort to compute; solved values always win
+    bool solved = (pn == 0 || dn == 0);
+    bool slotSolved = (entry.pn == 0 || entry.dn == 0);
+    if (entry.work == 0 || entry.key == key || cost >= entry.work || (solved && !slotSolved)) {
+        entry.key = key;
+        entry.pn = pn;
+        entry.dn = dn;
+        entry.work = cost;
+    }
+}
+
+bool ProofSolver::terminalValue(const Game& game, std::uint32_t& pn, std::uint32_t& dn) const {
+    Player winner = game.getWinner();
+    bool success;
+    if (winner != Player::NONE) {
+        success = (winner == attacker);
+    } else if (game.isDraw()) {
+        success = drawIsSuccess;
+    } else {
+        return false;
+    }
+    pn = success ? 0 : INF;
+    dn = success ? INF : 0;
+    return true;
+}
+
+void ProofSolver::mid(const Game& game, std::uint32_t thpn, std::uint32_t thdn,
+                      std::uint32_t& pn, std::uint32_t& dn) {
+    // Symmetric copies of a position share one table entry
+    int symmetry = 0;
+    std::uint32_t key = BoardKey::canonical(BoardKey::fromGame(game), symmetry);
+    if (terminalValue(game, pn, dn)) {
+        return;
+    }
+
+    // A stored result that already exceeds the thresholds needs no work
+    lookup(key, pn, dn);
+    if (pn >= thpn || dn >= thdn) {
+        return;
+    }
+
+    nodeCount++;
+    if (maxNodes != 0 && nodeCount > maxNodes) {
+        aborted = true;
+        return;
+    }
+    std::uint64_t startNodes = nodeCount;
+
+    // Children with their current proof / disproof numbers
+    struct Child {
+        Game game;
+        std::uint32_t pn;
+        std::uint32_t dn;
+    };
+    std::vector<Child> children;
+    for (const auto& move : game.getAvailableMoves()) {
+        Child child{game, 1, 1};
+        child.game.makeMove(move.first, move.second);
+        if (!terminalValue(child.game, child.pn, child.dn)) {
+            int childSymmetry = 0;
+            lookup(BoardKey::canonical(BoardKey::fromGame(child.game), childSymmetry), child.pn, child.dn);
+        }
+        children.push_back(child);
+    }
+
+    // OR node: the attacker picks one move; AND node: every defence must fail
+    bool orNode = (game.getCurrentPlayer() == attacker);
+
+    while (true) {
+        if (orNode) {
+            pn = INF;
+            dn = 0;
+            for (const auto& child : children) {
+                pn = std::min(pn, child.pn);
+                dn = addCapped(dn, child.dn, INF);
+            }
+        } else {
+            pn = 0;
+            dn = INF;
+            for (const auto& child : children) {
+                pn = addCapped(pn, child.pn, INF);
+                dn = std::min(dn, child.dn);
+            }
+        }
+        if (pn >= thpn || dn >= thdn || aborted) {
+            break;
+        }
+
+        // Most-proving child and the runner-up value that bounds its threshold
+        std::size_t best = 0;
+        std::uint32_t second = INF;
+        for (std::size_t i = 1; i < children.size(); ++i) {
+            std::uint32_t value = orNode ? children[i].pn : children[i].dn;
+            std::uint32_t bestValue = orNode ? children[best].pn : children[best].dn;
+            if (value < bestValue) {
+                second = bestValue;
+                best = i;
+            } else if (value < second) {
+                second = value;
+            }
+        }
+
+        Child& child = children[best];
+        std::uint32_t childPn;
+        std::uint32_t childDn;
+        if (orNode) {
+            childPn = std::min(thpn, second + 1);
+            childDn = addCapped(thdn - dn, child.dn, INF);
+        } else {
+            childPn = addCapped(thpn - pn, child.pn, INF);
+            childDn = std::min(thdn, second + 1);
+        }
+        mid(child.game, childPn, childDn, child.pn, child.dn);
+    }
+
+    if (!aborted) {
+        store(key, pn, dn, nodeCount - startNodes);
+    }
+}
+
+bool ProofSolver::prove(const Game& game, bool drawCounts, bool& proven) {
+    std::fill(table.begin(), table.end(), Entry());
+    attacker = game.getCurrentPlayer();
+    drawIsSuccess = drawCounts;
+
+    std::uint32_t pn = 1;
+    std::uint32_t dn = 1;
+    mid(game, INF, INF, pn, dn);
+    proven = (pn == 0);
+    return !aborted;
+}
+
+ProofResult ProofSolver::solve(const Game& game) {
+    nodeCount = 0;
+    aborted = false;
+
+    // Finished games: a winner is always the player who just moved
+    if (game.getWinner() != Player::NONE) return ProofResult::LOSS;
+    if (game.isDraw()) return ProofResult::DRAW;
+
+    bool wins = false;
+    if (!prove(game, false, wins)) return ProofResult::UNKNOWN;
+    if (wins) return ProofResult::WIN;
+
+    bool holds = false;
+    if (!prove(game, true, holds)) return ProofResult::UNKNOWN;
+    return holds ? ProofResult::DRAW : ProofResult::LOSS;
+}
+
+std::uint64_t ProofSolver::nodes() const {
+    return nodeCount;
+}
+
+std::size_t ProofSolver::tableSize() const {
+    return table.size();
+}
+
+const char* ProofSolver::resultName(ProofResult result) {
+    switch (result) {
+    case ProofResult::WIN: return "Win";
+    case ProofResult::DRAW: return "Draw";
+    case ProofResult::LOSS: return "Loss";
+    case ProofResult::UNKNOWN: return "Unknown";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,186 @@
+// SampleFile.cpp
+#include "SampleFile.h"
+#include <algorithm>
+#include <cstring>     // For memcmp / memcpy
+
+namespace {
+    // File layout: header, chunks of samples, chunk index, footer
+    struct SampleHeader {
+        char magic[4];              // "TTTS"
+        std::uint32_t version;
+        std::uint32_t sampleSize;   // sizeof(TrainingSample), guards against layout changes
+        std::uint32_t chunkCapacity;
+    };
+
+    struct SampleFooter {
+        std::uint64_t indexOffset;  // Byte offset of the first SampleChunk
+        std::uint32_t chunkCount;
+        char magic[4];              // "TTTI", written last: marks a complete file
+    };
+
+    const char SAMPLE_MAGIC[4] = {'T', 'T', 'T', 'S'};
+    const char INDEX_MAGIC[4] = {'T', 'T', 'T', 'I'};
+    const std::uint32_t SAMPLE_VERSION = 1;
+
+    // Longest possible game: one sample per cell
+    const std::size_t MAX_GAME_SAMPLES = 9;
+}
+
+SampleWriter::SampleWriter(std::size_t chunkCapacity)
+    : chunkGames(0), chunkCapacity(std::max(chunkCapacity, MAX_GAME_SAMPLES)),
+      offset(0), samplesWritten(0), gamesWritten(0) {}
+
+SampleWriter::~SampleWriter() {
+    close();
+}
+
+bool SampleWriter::open(const std::string& path) {
+    close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    SampleHeader header;
+    std::memcpy(header.magic, SAMPLE_MAGIC, sizeof(SAMPLE_MAGIC));
+    header.version = SAMPLE_VERSION;
+    header.sampleSize = sizeof(TrainingSample);
+    header.chunkCapacity = static_cast<std::uint32_t>(chunkCapacity);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    chunk.clear();
+    chunk.reserve(chunkCapacity);
+    chunkGames = 0;
+    index.clear();
+    offset = sizeof(header);
+    samplesWritten = 0;
+    gamesWritten = 0;
+    return out.good();
+}
+
+bool SampleWriter::flushChunk() {
+    if (chunk.empty()) {
+        return true;
+    }
+    out.write(reinterpret_cast<const char*>(chunk.data()),
+              static_cast<std::streamsize>(chunk.size() * sizeof(TrainingSample)));
+    index.push_back({offset, static_cast<std::uint32_t>(chunk.size()), chunkGames});
+    offset += chunk.size() * sizeof(TrainingSample);
+    chunk.clear();
+    chunkGames = 0;
+    return out.good();
+}
+
+bool SampleWriter::addGame(const std::vector<TrainingSample>& samples) {
+    if (!out.is_open() || samples.size() > MAX_GAME_SAMPLES) {
+        return false;
+    }
+    if (chunk.size() + samples.size() > chunkCapacity && !flushChunk()) {
+        return false;
+    }
+    chunk.insert(chunk.end(), samples.begin(), samples.end());
+    chunkGames++;
+    samplesWritten += samples.size();
+    gamesWritten++;
+    return true;
+}
+
+bool SampleWriter::close() {
+    if (!out.is_open()) {
+        return true;
+    }
+    bool ok = flushChunk();
+
+    SampleFooter footer;
+    footer.indexOffset = offset;
+    footer.chunkCount = static_cast<std::uint32_t>(index.size());
+    std::memcpy(footer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    out.write(reinterpret_cast<const char*>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(SampleChunk)));
+    out.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+
+    ok = ok && out.good();
+    out.close();
+    index.clear();
+    return ok;
+}
+
+bool SampleWriter::isOpen() const {
+    return out.is_open();
+}
+
+std::uint64_t SampleWriter::sampleCount() const {
+    return samplesWritten;
+}
+
+std::uint64_t SampleWriter::gameCount() const {
+    return gamesWritten;
+}
+
+SampleReader::SampleReader() : index(nullptr), chunks(0), samples(0), games(0) {}
+
+bool SampleReader::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+
+    SampleHeader header;
+    SampleFooter footer;
+    if (file.size() < sizeof(header) + sizeof(footer)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    std::memcpy(&footer, file.data() + file.size() - sizeof(footer), sizeof(footer));
+    if (std::memcmp(header.magic, SAMPLE_MAGIC, sizeof(SAMPLE_MAGIC)) != 0 ||
+        header.version != SAMPLE_VERSION || header.sampleSize != sizeof(TrainingSample) ||
+        std::memcmp(footer.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        footer.indexOffset + footer.chunkCount * sizeof(SampleChunk) + sizeof(footer) != file.size()) {
+        close();
+        return false;
+    }
+
+    // Every chunk must lie inside the sample area
+    index = reinterpret_cast<const SampleChunk*>(file.data() + footer.indexOffset);
+    chunks = footer.chunkCount;
+    for (std::size_t i = 0; i < chunks; ++i) {
+        if (index[i].offset < sizeof(header) ||
+            index[i].offset + index[i].sampleCount * sizeof(TrainingSample) > footer.indexOffset) {
+            close();
+            return false;
+        }
+        samples += index[i].sampleCount;
+        games += index[i].gameCount;
+    }
+    return true;
+}
+
+void SampleReader::close() {
+    file.close();
+    index = nullptr;
+    chunks = 0;
+    samples = 0;
+    games = 0;
+}
+
+std::size_t SampleReader::chunkCount() const {
+    return chunks;
+}
+
+std::uint64_t SampleReader::sampleCount() const {
+    return samples;
+}
+
+std::uint64_t SampleReader::gameCount() const {
+    return games;
+}
+
+const TrainingSample* SampleReader::chunk(std::size_t i, std::size_t& count) const {
+    if (i >= chunks) {
+        count = 0;
+        return nullptr;
+    }
+    count = index[i].sampleCount;
+    return reinterpret_cast<const TrainingSample*>(file.data() + index[i].offset);
+}
@@ -0,0 +1,69 @@
+// SearchStats.cpp
+#include "SearchStats.h"
+#include <sstream>     // For building the log line
+
+void SearchCounters::reset() {
+    *this = SearchCounters();
+}
+
+void SearchCounters::merge(const SearchCounters& other) {
+    nodes += other.nodes;
+    leafEvaluations += other.leafEvaluations;
+    ttProbes += other.ttProbes;
+    ttHits += other.ttHits;
+    threatNodes += other.threatNodes;
+    for (int i = 0; i < MAX_MOVES; ++i) {
+        cutoffsByMoveIndex[i] += other.cutoffsByMoveIndex[i];
+    }
+    if (other.depthReached > depthReached) {
+        depthReached = other.depthReached;
+    }
+}
+
+std::uint64_t SearchStats::totalCutoffs() const {
+    std::uint64_t total = 0;
+    for (auto count : counters.cutoffsByMoveIndex) {
+        total += count;
+    }
+    return total;
+}
+
+double SearchStats::nodesPerSecond() const {
+    if (elapsed.count() <= 0) return 0.0;
+    return static_cast<double>(counters.nodes) * 1e6 / static_cast<double>(elapsed.count());
+}
+
+double SearchStats::ttHitRate() const {
+    if (counters.ttProbes == 0) return 0.0;
+    return static_cast<double>(counters.ttHits) / static_cast<double>(counters.ttProbes);
+}
+
+std::string SearchStats::toString() const {
+    std::ostringstream ss;
+    if (fromTablebase) {
+        ss << "tablebase ";
+    } else if (fromBook) {
+        ss << "book ";
+    } else if (fromThreatSearch) {
+        ss << "forced-win ";
+    }
+    ss << "nodes=" << counters.nodes
+       << " leaves=" << counters.leafEvaluations
+       << " cutoffs=" << totalCutoffs();
+
+    // Share of cutoffs produced by the first move tried (move ordering quality)
+    if (totalCutoffs() > 0) {
+        ss << " (first=" << (100 * counters.cutoffsByMoveIndex[0] / totalCutoffs()) << "%)";
+    }
+
+    ss << " tt=" << counters.ttHits << "/" << counters.ttProbes
+       << " threat-nodes=" << counters.threatNodes
+       << " depth=" << counters.depthReached
+       << " time=" << elapsed.count() << "us"
+       << " nps=" << static_cast<std::uint64_t>(nodesPerSecond())
+       << " pv=";
+    for (const auto& move : principalVariation) {
+        ss << "(" << move.first << "," << move.second << ")";
+    }
+    return ss.str();
+}
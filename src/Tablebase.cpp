@@ -0,0 +1,305 @@
+// Tablebase.cpp
+#include "Tablebase.h"
+#include "BoardKey.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <bitset>      // For popcount
+#include <cstring>     // For memcmp / memcpy
+#include <fstream>     // For writing the tablebase file
+#include <set>
+#include <vector>
+
+namespace {
+    // File layout: header, bitmap words, rank directory, packed values
+    struct TablebaseHeader {
+        char magic[4];              // "TTTE"
+        std::uint32_t version;
+        std::uint32_t positionCount;
+        std::uint32_t wordCount;    // Bitmap words, guards against a different indexing
+    };
+
+    const char TABLEBASE_MAGIC[4] = {'T', 'T', 'T', 'E'};
+    const std::uint32_t TABLEBASE_VERSION = 1;
+
+    constexpr int CODE_COUNT = 19683;                       // 3^9 boards
+    constexpr std::uint32_t WORD_COUNT = (CODE_COUNT + 63) / 64;
+
+    const std::uint32_t LINES[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+
+    // Packed value: bits 0-1 outcome, bits 2-5 distance
+    enum : std::uint8_t { PACKED_LOSS = 0, PACKED_DRAW = 1, PACKED_WIN = 2 };
+
+    std::uint8_t pack(std::uint8_t outcome, int distance) {
+        return static_cast<std::uint8_t>(outcome | (distance << 2));
+    }
+
+    int unpackDistance(std::uint8_t value) {
+        return value >> 2;
+    }
+
+    // Orders values from the mover's side: fast wins first, slow losses last
+    int preference(std::uint8_t value) {
+        switch (value & 3) {
+        case PACKED_WIN: return 100 - unpackDistance(value);
+        case PACKED_LOSS: return -100 + unpackDistance(value);
+        default: return 0;
+        }
+    }
+
+    // Value of the position for the side to move after the opponent reached
+    // a child worth 'child' to them
+    std::uint8_t fromChild(std::uint8_t child) {
+        int distance = unpackDistance(child) + 1;
+        switch (child & 3) {
+        case PACKED_WIN: return pack(PACKED_LOSS, distance);
+        case PACKED_LOSS: return pack(PACKED_WIN, distance);
+        default: return pack(PACKED_DRAW, distance);
+        }
+    }
+
+    // Base-3 code of a key, cell 0 is the lowest digit
+    int codeOf(std::uint32_t key) {
+        int code = 0;
+        for (int cell = 8; cell >= 0; --cell) {
+            code = code * 3 + ((key & (1u << cell)) ? 1 : (key & (1u << (cell + 9))) ? 2 : 0);
+        }
+        return code;
+    }
+
+    bool xToMove(std::uint32_t key) {
+        return BoardKey::countCells(key & 0x1FF) == BoardKey::countCells(key >> 9);
+    }
+
+    // Value of a finished game, false if the game goes on. Only the player
+    // who just moved can own a line.
+    bool terminalValue(std::uint32_t key, std::uint8_t& value) {
+        std::uint32_t lastMover = xToMove(key) ? (key >> 9) : (key & 0x1FF);
+        for (std::uint32_t line : LINES) {
+            if ((lastMover & line) == line) {
+                value = pack(PACKED_LOSS, 0);
+                return true;
+            }
+        }
+        if (BoardKey::countCells(key) == 9) {
+            value = pack(PACKED_DRAW, 0);
+            return true;
+        }
+        return false;
+    }
+
+    int popcount(std::uint64_t bits) {
+        return static_cast<int>(std::bitset<64>(bits).count());
+    }
+}
+
+Tablebase::Tablebase() : bitmap(nullptr), ranks(nullptr), values(nullptr), positionCount(0) {}
+
+bool Tablebase::open(const std::string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+
+    // Validate the header and section sizes before trusting the data
+    TablebaseHeader header;
+    if (file.size() < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    std::size_t expected = sizeof(header) + WORD_COUNT * (sizeof(std::uint64_t) + sizeof(std::uint16_t)) +
+                           header.positionCount;
+    if (std::memcmp(header.magic, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC)) != 0 ||
+        header.version != TABLEBASE_VERSION || header.wordCount != WORD_COUNT || file.size() != expected) {
+        close();
+        return false;
+    }
+
+    bitmap = reinterpret_cast<const std::uint64_t*>(file.data() + sizeof(header));
+    ranks = reinterpret_cast<const std::uint16_t*>(bitmap + WORD_COUNT);
+    values = reinterpret_cast<const std::uint8_t*>(ranks + WORD_COUNT);
+
+    // The rank directory must agree with the bitmap
+    std::size_t total = 0;
+    for (std::uint32_t word = 0; word < WORD_COUNT; ++word) {
+        if (ranks[word] != total) {
+            close();
+            return false;
+        }
+        total += popcount(bitmap[word]);
+    }
+    if (total != header.positionCount) {
+        close();
+        return false;
+    }
+
+    positionCount = header.positionCount;
+    return true;
+}
+
+void Tablebase::close() {
+    file.close();
+    bitmap = nullptr;
+    ranks = nullptr;
+    values = nullptr;
+    positionCount = 0;
+}
+
+bool Tablebase::isOpen() const {
+    return file.isOpen() && bitmap != nullptr;
+}
+
+std::size_t Tablebase::size() const {
+    return positionCount;
+}
+
+bool Tablebase::lookup(const Game& game, std::uint8_t& value) const {
+    if (bitmap == nullptr) {
+        return false;
+    }
+
+    int symmetry = 0;
+    int code = codeOf(BoardKey::canonical(BoardKey::fromGame(game), symmetry));
+    std::uint64_t word = bitmap[code >> 6];
+    std::uint64_t bit = 1ull << (code & 63);
+    if (!(word & bit)) {
+        return false;
+    }
+    value = values[ranks[code >> 6] + popcount(word & (bit - 1))];
+    return true;
+}
+
+bool Tablebase::probe(const Game& game, ProofResult& result, int& distance) const {
+    std::uint8_t value;
+    if (!lookup(game, value)) {
+        return false;
+    }
+    result = ((value & 3) == PACKED_WIN) ? ProofResult::WIN
+           : ((value & 3) == PACKED_LOSS) ? ProofResult::LOSS
+           : ProofResult::DRAW;
+    distance = unpackDistance(value);
+    return true;
+}
+
+bool Tablebase::bestMove(const Game& game, std::pair<int, int>& move) const {
+    if (game.getWinner() != Player::NONE) {
+        return false;
+    }
+
+    int bestPreference = -1000;
+    for (const auto& candidate : game.getAvailableMoves()) {
+        Game child = game;
+        child.makeMove(candidate.first, candidate.second);
+        std::uint8_t childValue;
+        if (!lookup(child, childValue)) {
+            return false;
+        }
+        int value = preference(fromChild(childValue));
+        if (value > bestPreference) {
+            bestPreference = value;
+            move = candidate;
+        }
+    }
+    return bestPreference > -1000;
+}
+
+bool Tablebase::generate(const std::string& path, unsigned int threads) {
+    // Canonical positions by number of marks, found by playing forward
+    std::vector<std::uint32_t> layers[10];
+    layers[0].push_back(0);
+    for (int marks = 0; marks < 9; ++marks) {
+        std::set<std::uint32_t> next;
+        for (std::uint32_t key : layers[marks]) {
+            std::uint8_t value;
+            if (terminalValue(key, value)) {
+                continue;
+            }
+            int shift = xToMove(key) ? 0 : 9;
+            for (int cell = 0; cell < 9; ++cell) {
+                if (!(key & ((1u << cell) | (1u << (cell + 9))))) {
+                    int symmetry = 0;
+                    next.insert(BoardKey::canonical(key | (1u << (cell + shift)), symmetry));
+                }
+            }
+        }
+        layers[marks + 1].assign(next.begin(), next.end());
+    }
+
+    // Retrograde pass: every move adds a mark, so a layer only depends on
+    // the next one and its positions can be solved independently
+    std::vector<std::uint8_t> layerValues[10];
+    ThreadPool pool(threads);
+    for (int marks = 9; marks >= 0; --marks) {
+        const std::vector<std::uint32_t>& layer = layers[marks];
+        layerValues[marks].assign(layer.size(), 0);
+        std::size_t blockSize = layer.size() / pool.threadCount() + 1;
+
+        for (std::size_t begin = 0; begin < layer.size(); begin += blockSize) {
+            std::size_t end = std::min(layer.size(), begin + blockSize);
+            pool.submit([&, marks, begin, end] {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::uint32_t key = layer[i];
+                    std::uint8_t best = 0;
+                    if (terminalValue(key, best)) {
+                        layerValues[marks][i] = best;
+                        continue;
+                    }
+
+                    int shift = xToMove(key) ? 0 : 9;
+                    int bestPreference = -1000;
+                    const std::vector<std::uint32_t>& children = layers[marks + 1];
+                    for (int cell = 0; cell < 9; ++cell) {
+                        if (key & ((1u << cell) | (1u << (cell + 9)))) {
+                            continue;
+                        }
+                        int symmetry = 0;
+                        std::uint32_t child = BoardKey::canonical(key | (1u << (cell + shift)), symmetry);
+                        auto found = std::lower_bound(children.begin(), children.end(), child);
+                        std::uint8_t value = fromChild(layerValues[marks + 1][found - children.begin()]);
+                        if (preference(value) > bestPreference) {
+                            bestPreference = preference(value);
+                            best = value;
+                        }
+                    }
+                    layerValues[marks][i] = best;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    // Index: bitmap over base-3 codes, values in code order
+    std::vector<std::pair<int, std::uint8_t>> byCode;
+    for (int marks = 0; marks <= 9; ++marks) {
+        for (std::size_t i = 0; i < layers[marks].size(); ++i) {
+            byCode.emplace_back(codeOf(layers[marks][i]), layerValues[marks][i]);
+        }
+    }
+    std::sort(byCode.begin(), byCode.end());
+
+    std::vector<std::uint64_t> bitmapWords(WORD_COUNT, 0);
+    std::vector<std::uint16_t> rankWords(WORD_COUNT, 0);
+    std::vector<std::uint8_t> packed;
+    for (const auto& entry : byCode) {
+        bitmapWords[entry.first >> 6] |= 1ull << (entry.first & 63);
+        packed.push_back(entry.second);
+    }
+    for (std::uint32_t word = 1; word < WORD_COUNT; ++word) {
+        rankWords[word] = static_cast<std::uint16_t>(rankWords[word - 1] + popcount(bitmapWords[word - 1]));
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    TablebaseHeader header;
+    std::memcpy(header.magic, TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC));
+    header.version = TABLEBASE_VERSION;
+    header.positionCount = static_cast<std::uint32_t>(packed.size());
+    header.wordCount = WORD_COUNT;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(bitmapWords.data()), bitmapWords.size() * sizeof(std::uint64_t));
+    out.write(reinterpret_cast<const char*>(rankWords.data()), rankWords.size() * sizeof(std::uint16_t));
+    out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+    return out.good();
+}
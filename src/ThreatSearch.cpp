@@ -0,0 +1,112 @@
+// ThreatSearch.cpp
+#include "ThreatSearch.h"
+#include "BoardKey.h"
+
+namespace {
+    // The 8 winning lines as cell masks: rows, columns, diagonals
+    const std::uint16_t LINES[8] = {0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054};
+
+    int lowestCell(std::uint16_t cells) {
+        int cell = 0;
+        while (!(cells & (1u << cell))) cell++;
+        return cell;
+    }
+}
+
+ThreatSearch::ThreatSearch(int maxAttackerMoves) : maxAttackerMoves(maxAttackerMoves), nodeCount(0) {}
+
+std::uint16_t ThreatSearch::winningCells(std::uint16_t mine, std::uint16_t theirs) {
+    std::uint16_t cells = 0;
+    for (std::uint16_t line : LINES) {
+        if ((line & theirs) == 0 && BoardKey::countCells(line & mine) == 2) {
+            cells |= line & ~mine;
+        }
+    }
+    return cells;
+}
+
+bool ThreatSearch::search(std::uint16_t mine, std::uint16_t theirs, int movesLeft, std::vector<int>& line) {
+    nodeCount++;
+
+    // A threat already on the board wins on the spot
+    std::uint16_t wins = winningCells(mine, theirs);
+    if (wins) {
+        line.push_back(lowestCell(wins));
+        return true;
+    }
+    if (movesLeft == 0) {
+        return false;
+    }
+
+    // If the opponent threatens to win, only the block is playable
+    std::uint16_t mustBlock = winningCells(theirs, mine);
+    if (BoardKey::countCells(mustBlock) > 1) {
+        return false;
+    }
+
+    std::uint16_t empty = static_cast<std::uint16_t>(~(mine | theirs) & 0x1FF);
+    for (int cell = 0; cell < 9; ++cell) {
+        std::uint16_t bit = static_cast<std::uint16_t>(1u << cell);
+        if (!(empty & bit) || (mustBlock && !(mustBlock & bit))) {
+            continue;
+        }
+
+        std::uint16_t nextMine = mine | bit;
+        std::uint16_t threats = winningCells(nextMine, theirs);
+        if (!threats || winningCells(theirs, nextMine)) {
+            continue; // Quiet move, or the opponent simply wins first
+        }
+
+        if (BoardKey::countCells(threats) >= 2) {
+            // Double threat: whichever cell is blocked, the other one wins
+            int blocked = lowestCell(threats);
+            line.push_back(cell);
+            line.push_back(blocked);
+            line.push_back(lowestCell(static_cast<std::uint16_t>(threats & ~(1u << blocked))));
+            return true;
+        }
+
+        // Single threat: the reply is forced, keep attacking from there
+        int reply = lowestCell(threats);
+        line.push_back(cell);
+        line.push_back(reply);
+        if (search(nextMine, theirs | static_cast<std::uint16_t>(1u << reply), movesLeft - 1, line)) {
+            return true;
+        }
+        line.pop_back();
+        line.pop_back();
+    }
+    return false;
+}
+
+bool ThreatSearch::findForcedWin(const Game& game, std::vector<std::pair<int, int>>& line) {
+    nodeCount = 0;
+    line.clear();
+    if (game.getWinner() != Player::NONE || game.isDraw()) {
+        return false;
+    }
+
+    std::uint32_t key = BoardKey::fromGame(game);
+    std::uint16_t xCells = static_cast<std::uint16_t>(key & 0x1FF);
+    std::uint16_t oCells = static_cast<std::uint16_t>(key >> 9);
+    bool xToMove = game.getCurrentPlayer() == Player::X;
+    std::uint16_t mine = xToMove ? xCells : oCells;
+    std::uint16_t theirs = xToMove ? oCells : xCells;
+
+    // Deepen one attacking move at a time so the shortest forced win is found
+    std::vector<int> cells;
+    for (int moves = 0; moves <= maxAttackerMoves; ++moves) {
+        cells.clear();
+        if (search(mine, theirs, moves, cells)) {
+            for (int cell : cells) {
+                line.emplace_back(cell / 3, cell % 3);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t ThreatSearch::nodes() const {
+    return nodeCount;
+}
@@ -0,0 +1,162 @@
+// Tournament.cpp
+#include "Tournament.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta)
+    : elo0(elo0), elo1(elo1), lower(std::log(beta / (1.0 - alpha))), upper(std::log((1.0 - beta) / alpha)) {}
+
+double Sprt::expectedScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double Sprt::eloFromScore(double score) {
+    score = std::max(1e-6, std::min(score, 1.0 - 1e-6));
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double Sprt::llr(std::uint64_t wins, std::uint64_t draws, std::uint64_t losses) const {
+    // One virtual win and loss keep the variance positive while every game
+    // so far was drawn (common between strong engines)
+    double w = static_cast<double>(wins) + 1.0;
+    double d = static_cast<double>(draws);
+    double l = static_cast<double>(losses) + 1.0;
+    double n = w + d + l;
+
+    double mean = (w + 0.5 * d) / n;
+    double variance = (w * (1.0 - mean) * (1.0 - mean) + d * (0.5 - mean) * (0.5 - mean) +
+                       l * mean * mean) / n;
+    double s0 = expectedScore(elo0);
+    double s1 = expectedScore(elo1);
+    return n * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+}
+
+SprtDecision Sprt::decide(std::uint64_t wins, std::uint64_t draws, std::uint64_t losses) const {
+    double ratio = llr(wins, draws, losses);
+    if (ratio >= upper) return SprtDecision::ACCEPT_H1;
+    if (ratio <= lower) return SprtDecision::ACCEPT_H0;
+    return SprtDecision::CONTINUE;
+}
+
+double Sprt::lowerBound() const {
+    return lower;
+}
+
+double Sprt::upperBound() const {
+    return upper;
+}
+
+std::uint64_t TournamentResult::games() const {
+    return wins + draws + losses;
+}
+
+double TournamentResult::score() const {
+    if (games() == 0) return 0.5;
+    return (static_cast<double>(wins) + 0.5 * static_cast<double>(draws)) / static_cast<double>(games());
+}
+
+double TournamentResult::elo() const {
+    return Sprt::eloFromScore(score());
+}
+
+double TournamentResult::eloMargin() const {
+    if (games() == 0) return 0.0;
+    double n = static_cast<double>(games());
+    double mean = score();
+    double variance = (wins * (1.0 - mean) * (1.0 - mean) + draws * (0.5 - mean) * (0.5 - mean) +
+                       losses * mean * mean) / n;
+    double deviation = 1.96 * std::sqrt(variance / n);
+    return (Sprt::eloFromScore(mean + deviation) - Sprt::eloFromScore(mean - deviation)) / 2.0;
+}
+
+Tournament::Tournament(const TournamentSettings& settings) : settings(settings) {}
+
+std::string Tournament::decisionName(SprtDecision decision) {
+    switch (decision) {
+    case SprtDecision::ACCEPT_H0: return "H0";
+    case SprtDecision::ACCEPT_H1: return "H1";
+    case SprtDecision::CONTINUE: return "inconclusive";
+    }
+    return "unknown";
+}
+
+TournamentResult Tournament::run(const std::function<void(const TournamentGame&)>& onGame) {
+    ThreadPool pool(settings.threads);
+    std::uint64_t pairs = (settings.maxGames + 1) / 2;
+    std::atomic<std::uint64_t> nextPair{0};
+    std::atomic<bool> decided{false};
+
+    std::mutex resultMutex;
+    TournamentResult result;
+    std::uint64_t gameIndex = 0;
+
+    for (std::size_t w = 0; w < pool.threadCount(); ++w) {
+        pool.submit([&, w] {
+            // Every engine plays one colour; caches carry over between games
+            AI aAsX(Player::X, settings.engineA.limits);
+            AI aAsO(Player::O, settings.engineA.limits);
+            AI bAsX(Player::X, settings.engineB.limits);
+            AI bAsO(Player::O, settings.engineB.limits);
+            unsigned int engineSeed = settings.seed * 7919u + static_cast<unsigned int>(w) * 4u;
+            aAsX.setRandomSeed(engineSeed);
+            aAsO.setRandomSeed(engineSeed + 1);
+            bAsX.setRandomSeed(engineSeed + 2);
+            bAsO.setRandomSeed(engineSeed + 3);
+
+            for (std::uint64_t pair = nextPair++; pair < pairs && !decided; pair = nextPair++) {
+                // The opening depends only on the seed and the pair number
+                std::mt19937 rng(settings.seed + static_cast<unsigned int>(pair));
+                Game opening;
+                std::string openingMoves;
+                for (int ply = 0; ply < settings.randomPlies && opening.getWinner() == Player::NONE &&
+                                  !opening.isDraw(); ++ply) {
+                    auto moves = opening.getAvailableMoves();
+                    auto move = moves[std::uniform_int_distribution<std::size_t>(0, moves.size() - 1)(rng)];
+                    opening.makeMove(move.first, move.second);
+                    openingMoves += static_cast<char>('0' + move.first * 3 + move.second);
+                }
+
+                for (int round = 0; round < 2; ++round) {
+                    TournamentGame record{0, pair, round == 0, 0, openingMoves};
+                    AI& xEngine = record.aPlaysX ? aAsX : bAsX;
+                    AI& oEngine = record.aPlaysX ? bAsO : aAsO;
+
+                    Game game = opening;
+                    while (game.getWinner() == Player::NONE && !game.isDraw()) {
+                        AI& mover = (game.getCurrentPlayer() == Player::X) ? xEngine : oEngine;
+                        auto move = mover.findBestMove(game);
+                        game.makeMove(move.first, move.second);
+                        record.moves += static_cast<char>('0' + move.first * 3 + move.second);
+                    }
+
+                    Player aPlayer = record.aPlaysX ? Player::X : Player::O;
+                    Player winner = game.getWinner();
+                    record.result = (winner == Player::NONE) ? 0 : (winner == aPlayer) ? 1 : -1;
+
+                    std::lock_guard<std::mutex> lock(resultMutex);
+                    if (result.decision != SprtDecision::CONTINUE) {
+                        break; // Another worker already finished the match
+                    }
+                    record.index = gameIndex++;
+                    if (record.result > 0) result.wins++;
+                    else if (record.result < 0) result.losses++;
+                    else result.draws++;
+                    result.llr = settings.sprt.llr(result.wins, result.draws, result.losses);
+                    result.decision = settings.sprt.decide(result.wins, result.draws, result.losses);
+                    if (result.decision != SprtDecision::CONTINUE) {
+                        decided = true;
+                    }
+                    if (onGame) {
+                        onGame(record);
+                    }
+                }
+            }
+        });
+    }
+    pool.wait();
+    return result;
+}
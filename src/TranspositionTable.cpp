@@ -0,0 +1,233 @@
+// TranspositionTable.cpp
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <new>         // For placement new
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+#ifdef __linux__
+    // 2 MiB huge pages; smaller tables are not worth a huge page
+    const std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+#endif
+
+    // Slot layout, low bits first: key 32, score 16, depth 5, bound 2,
+    // best move 4 (15 = none), generation 5
+    const int SCORE_SHIFT = 32;
+    const int DEPTH_SHIFT = 48;
+    const int BOUND_SHIFT = 53;
+    const int MOVE_SHIFT = 55;
+    const int GENERATION_SHIFT = 59;
+    const std::uint64_t NO_MOVE = 0xF;
+    const int MAX_DEPTH = 31;
+    const int GENERATION_MASK = 31;
+
+    // Largest power of two not above 'value' (at least 1)
+    std::size_t floorPowerOfTwo(std::size_t value) {
+        std::size_t size = 1;
+        while (size * 2 <= value) {
+            size <<= 1;
+        }
+        return size;
+    }
+}
+
+TranspositionTable::TranspositionTable(std::size_t entryCount)
+    : buckets(nullptr), bucketCount(0), mask(0), mapped(false), hugePages(false), generation(0) {
+    // Round up to a power of two so the index is a simple mask
+    std::size_t count = 1;
+    while (count * BUCKET_SIZE < entryCount) {
+        count <<= 1;
+    }
+    allocate(count, false);
+}
+
+TranspositionTable::~TranspositionTable() {
+    release();
+}
+
+TranspositionTable::TranspositionTable(const TranspositionTable& other)
+    : buckets(nullptr), bucketCount(0), mask(0), mapped(false), hugePages(false), generation(0) {
+    allocate(other.bucketCount, other.hugePages);
+    copySlots(other);
+}
+
+TranspositionTable& TranspositionTable::operator=(const TranspositionTable& other) {
+    if (this != &other) {
+        allocate(other.bucketCount, other.hugePages);
+        copySlots(other);
+    }
+    return *this;
+}
+
+void TranspositionTable::copySlots(const TranspositionTable& other) {
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        for (std::size_t j = 0; j < BUCKET_SIZE; ++j) {
+            buckets[i].slots[j].store(other.buckets[i].slots[j].load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+        }
+    }
+    generation = other.generation;
+}
+
+std::uint64_t TranspositionTable::pack(const TTEntry& entry) {
+    std::uint64_t move = (entry.bestMove == 0xFF) ? NO_MOVE : entry.bestMove;
+    return std::uint64_t(entry.key) |
+           std::uint64_t(static_cast<std::uint16_t>(entry.score)) << SCORE_SHIFT |
+           std::uint64_t(std::min<int>(entry.depth, MAX_DEPTH)) << DEPTH_SHIFT |
+           std::uint64_t(static_cast<std::uint8_t>(entry.bound)) << BOUND_SHIFT |
+           move << MOVE_SHIFT |
+           std::uint64_t(entry.generation & GENERATION_MASK) << GENERATION_SHIFT;
+}
+
+TTEntry TranspositionTable::unpack(std::uint64_t slot) {
+    TTEntry entry;
+    entry.key = static_cast<std::uint32_t>(slot);
+    entry.score = static_cast<std::int16_t>(static_cast<std::uint16_t>(slot >> SCORE_SHIFT));
+    entry.depth = static_cast<std::uint8_t>((slot >> DEPTH_SHIFT) & MAX_DEPTH);
+    entry.bound = static_cast<Bound>((slot >> BOUND_SHIFT) & 3);
+    std::uint64_t move = (slot >> MOVE_SHIFT) & NO_MOVE;
+    entry.bestMove = static_cast<std::uint8_t>(move == NO_MOVE ? 0xFF : move);
+    entry.generation = static_cast<std::uint8_t>(slot >> GENERATION_SHIFT);
+    return entry;
+}
+
+void TranspositionTable::allocate(std::size_t count, bool useHugePages) {
+    release();
+    std::size_t bytes = count * sizeof(Bucket);
+    hugePages = useHugePages;
+
+#ifdef __linux__
+    if (useHugePages && bytes >= HUGE_PAGE_SIZE) {
+        // Reserved huge pages first, then ordinary pages with a THP hint
+        void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory == MAP_FAILED) {
+            memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory != MAP_FAILED) {
+                madvise(memory, bytes, MADV_HUGEPAGE);
+            }
+        }
+        if (memory != MAP_FAILED) {
+            buckets = new (memory) Bucket[count];
+            mapped = true;
+        }
+    }
+#endif
+
+    if (buckets == nullptr) {
+        buckets = new Bucket[count];
+    }
+    bucketCount = count;
+    mask = count - 1;
+    clear();
+}
+
+void TranspositionTable::release() {
+    if (buckets == nullptr) {
+        return;
+    }
+#ifdef __linux__
+    if (mapped) {
+        munmap(buckets, bucketCount * sizeof(Bucket));
+    } else {
+        delete[] buckets;
+    }
+#else
+    delete[] buckets;
+#endif
+    buckets = nullptr;
+    bucketCount = 0;
+    mapped = false;
+}
+
+void TranspositionTable::resize(std::size_t bytes, bool useHugePages) {
+    allocate(floorPowerOfTwo(std::max(bytes / sizeof(Bucket), std::size_t(1))), useHugePages);
+}
+
+TranspositionTable::Bucket& TranspositionTable::bucketOf(std::uint32_t key) const {
+    // Fibonacci hashing spreads the structured position keys over the table
+    return buckets[static_cast<std::size_t>((key * 2654435769u) >> 8) & mask];
+}
+
+bool TranspositionTable::probe(std::uint32_t key, TTEntry& out) const {
+    for (const auto& slot : bucketOf(key).slots) {
+        TTEntry entry = unpack(slot.load(std::memory_order_relaxed));
+        if (entry.bound != Bound::NONE && entry.key == key) {
+            out = entry;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint32_t key, int score, int depth, Bound bound, int bestMove) {
+    Bucket& bucket = bucketOf(key);
+
+    // Same position, else the entry worth least: empty, then old, then shallow
+    std::atomic<std::uint64_t>* victim = &bucket.slots[0];
+    TTEntry old = unpack(victim->load(std::memory_order_relaxed));
+    int victimWorth = 0x7FFFFFFF;
+    for (auto& slot : bucket.slots) {
+        TTEntry entry = unpack(slot.load(std::memory_order_relaxed));
+        if (entry.bound != Bound::NONE && entry.key == key) {
+            victim = &slot;
+            old = entry;
+            break;
+        }
+        int age = (generation - entry.generation) & GENERATION_MASK;
+        int worth = (entry.bound == Bound::NONE) ? -0x10000 : entry.depth - 4 * age;
+        if (worth < victimWorth) {
+            victimWorth = worth;
+            victim = &slot;
+            old = entry;
+        }
+    }
+
+    // Keep the best move of a previous search when this one has none
+    if (bestMove < 0 && old.bound != Bound::NONE && old.key == key) {
+        bestMove = (old.bestMove == 0xFF) ? -1 : old.bestMove;
+    }
+
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<std::int16_t>(score);
+    entry.depth = static_cast<std::uint8_t>(std::min(std::max(depth, 0), MAX_DEPTH));
+    entry.bound = bound;
+    entry.bestMove = static_cast<std::uint8_t>(bestMove < 0 ? 0xFF : bestMove);
+    entry.generation = generation;
+    victim->store(pack(entry), std::memory_order_relaxed);
+}
+
+void TranspositionTable::newSearch() {
+    generation = static_cast<std::uint8_t>((generation + 1) & GENERATION_MASK);
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        for (auto& slot : buckets[i].slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+std::size_t TranspositionTable::size() const {
+    return bucketCount * BUCKET_SIZE;
+}
+
+std::size_t TranspositionTable::memoryUsage() const {
+    return bucketCount * sizeof(Bucket);
+}
+
+std::size_t TranspositionTable::occupied() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        for (const auto& slot : buckets[i].slots) {
+            if (slot.load(std::memory_order_relaxed) != 0) count++;
+        }
+    }
+    return count;
+}
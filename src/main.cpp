@@ -7,6 +7,7 @@
 #include <QFont>
 #include <QFontDatabase>
 #include "StartupWindow.h"
+#include "HistoryWriter.h"
 #include <QScreen>
 
 int main(int argc, char *argv[])
@@ -69,6 +70,12 @@ int main(int argc, char *argv[])
         (app.primaryScreen()->geometry().height() - startup.height()) / 2
         );
 
+    // Store queued results while the application is still whole, not from
+    // static destructors
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [] {
+        HistoryWriter::shared().flush();
+    });
+
     // Run the application
     return app.exec();
 }
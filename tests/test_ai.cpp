@@ -1,7 +1,7 @@
 #include <gtest/gtest.h>      // Google Test framework
 #include "AI.h"               // AI logic header
 #include "Game.h"             // Game logic header
-#include <chrono>             // For performance timing test
+#include <algorithm>          // For std::find_if
 #include <iostream>           // For debug printing
 
 
@@ -162,20 +162,86 @@ TEST_F(AITest, Performance) {
     Game game;
     AI ai(Player::X);
     
-    auto start = std::chrono::high_resolution_clock::now(); //Record the current time before calculating the AI move
     auto move = ai.findBestMove(game);
-    auto end = std::chrono::high_resolution_clock::now(); //Record the time after the move was found
+    const SearchStats& stats = ai.getLastSearchStats();
     
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start); //Calculate how long the AI took (in milliseconds)
-    
-    std::cout << "AI calculation time: " << duration.count() << "ms" << std::endl;
-    EXPECT_LT(duration.count(), 1000); // Less than 1 second
+    std::cout << "AI search: " << stats.toString() << std::endl;
+
+    // Work done by the search, instead of wall-clock time
+    EXPECT_GT(stats.counters.nodes, 0u);
+    EXPECT_LT(stats.counters.nodes, 60000u); // Full-board search stays within its node budget
+    EXPECT_LE(stats.counters.leafEvaluations, stats.counters.nodes);
+    EXPECT_GT(stats.totalCutoffs(), 0u); // Alpha-beta must prune something
+    EXPECT_GT(stats.counters.cutoffsByMoveIndex[0], 0u);
+    EXPECT_LE(stats.counters.depthReached, 10);
+    EXPECT_GT(stats.elapsed.count(), 0);
+    EXPECT_GT(stats.nodesPerSecond(), 0.0);
+
     EXPECT_GE(move.first, 0); //Validates that the move is within board limits (0 ≤ index < 3)
     EXPECT_LT(move.first, 3);
     EXPECT_GE(move.second, 0);
     EXPECT_LT(move.second, 3);
 }
 
+TEST_F(AITest, PrincipalVariationIsPlayable) {
+    Game game;
+    game.makeMove(0, 0); // X takes corner
+    
+    AI aiO(Player::O);
+    auto move = aiO.findBestMove(game);
+    const SearchStats& stats = aiO.getLastSearchStats();
+    
+    // The line starts with the chosen move and every move in it is legal
+    ASSERT_FALSE(stats.principalVariation.empty());
+    EXPECT_EQ(move, stats.principalVariation[0]);
+    for (const auto& pvMove : stats.principalVariation) {
+        ASSERT_TRUE(game.makeMove(pvMove.first, pvMove.second));
+    }
+    
+    // Optimal play from here is a draw, so the line runs to a full board
+    EXPECT_TRUE(game.isDraw());
+}
+
+TEST_F(AITest, StatsForShortcutMove) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(1, 0); // O
+    game.makeMove(0, 1); // X
+    game.makeMove(1, 1); // O
+    
+    // The immediate win is found before any tree search
+    AI aiX(Player::X);
+    auto move = aiX.findBestMove(game);
+    const SearchStats& stats = aiX.getLastSearchStats();
+    
+    EXPECT_EQ(0u, stats.counters.nodes);
+    ASSERT_EQ(1u, stats.principalVariation.size());
+    EXPECT_EQ(move, stats.principalVariation[0]);
+    EXPECT_TRUE(stats.scored);
+    int score = stats.score;
+    EXPECT_EQ(aiX.analyze(game).front().score, score);
+}
+
+TEST_F(AITest, StatsScoreChosenMove) {
+    // The searched move's value is the one a full analysis gives it
+    std::vector<Game> games(3);
+    games[1].makeMove(0, 0);
+    games[2].makeMove(1, 1);
+    games[2].makeMove(0, 1);
+    for (const Game& game : games) {
+        AI ai(game.getCurrentPlayer());
+        auto move = ai.findBestMove(game);
+        SearchStats stats = ai.getLastSearchStats();   // analyze replaces it
+        ASSERT_TRUE(stats.scored);
+
+        int expected = 0;
+        for (const auto& analysis : ai.analyze(game)) {
+            if (analysis.move == move) expected = analysis.score;
+        }
+        EXPECT_EQ(expected, stats.score);
+    }
+}
+
 // Additional test for AI vs AI scenario
 TEST_F(AITest, AIvsAI) {
     Game game;
@@ -223,4 +289,316 @@ TEST_F(AITest, ImmediateWinPriority) {
     // AI should prioritize the winning move
     EXPECT_EQ(0, move.first);
     EXPECT_EQ(2, move.second);
-}
\ No newline at end of file
+}
+// Lower difficulty levels must be cheaper searches, not full searches plus noise
+TEST_F(AITest, DifficultyBudgets) {
+    Game game;
+    game.makeMove(0, 0); // X
+    
+    AI hard(Player::O, Difficulty::HARD);
+    AI medium(Player::O, Difficulty::MEDIUM);
+    AI easy(Player::O, Difficulty::EASY);
+    hard.findBestMove(game);
+    medium.findBestMove(game);
+    easy.findBestMove(game);
+    
+    auto hardNodes = hard.getLastSearchStats().counters.nodes;
+    auto mediumNodes = medium.getLastSearchStats().counters.nodes;
+    auto easyNodes = easy.getLastSearchStats().counters.nodes;
+    std::cout << "Nodes - Easy: " << easyNodes << ", Medium: " << mediumNodes
+              << ", Hard: " << hardNodes << std::endl;
+    
+    EXPECT_LT(easyNodes * 10, hardNodes);
+    EXPECT_LT(mediumNodes, hardNodes);
+    EXPECT_LE(easyNodes, easy.getLimits().maxNodes);
+    EXPECT_LE(mediumNodes, medium.getLimits().maxNodes);
+    EXPECT_LE(easy.getLastSearchStats().counters.depthReached, easy.getLimits().maxDepth);
+}
+
+TEST_F(AITest, NodeCapStopsSearch) {
+    SearchLimits limits;
+    limits.maxNodes = 200;
+    
+    Game game;
+    AI capped(Player::X, limits);
+    auto move = capped.findBestMove(game);
+    
+    // Capped search still returns a legal move from its last finished pass
+    EXPECT_EQ(Player::NONE, game.at(move.first, move.second));
+    EXPECT_LE(capped.getLastSearchStats().counters.nodes, limits.maxNodes);
+}
+
+TEST_F(AITest, EasyStillTakesImmediateWin) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(1, 0); // O
+    game.makeMove(0, 1); // X
+    game.makeMove(2, 2); // O
+    
+    AI easy(Player::X, Difficulty::EASY);
+    auto move = easy.findBestMove(game);
+    EXPECT_EQ(0, move.first);
+    EXPECT_EQ(2, move.second);
+}
+
+TEST_F(AITest, AnalyzeScoresEveryMove) {
+    Game game;
+    game.makeMove(0, 0); // X takes corner
+    
+    // For O only the center holds the draw, every other reply loses
+    AI ai(Player::O);
+    auto analysis = ai.analyze(game);
+    ASSERT_EQ(game.getAvailableMoves().size(), analysis.size());
+    
+    EXPECT_EQ(std::make_pair(1, 1), analysis[0].move);
+    EXPECT_EQ(MoveOutcome::DRAW, analysis[0].outcome);
+    for (size_t i = 1; i < analysis.size(); ++i) {
+        EXPECT_EQ(MoveOutcome::LOSS, analysis[i].outcome);
+        EXPECT_GT(analysis[i].distance, 0);
+        EXPECT_LE(analysis[i].score, analysis[i - 1].score); // Sorted best first
+    }
+    
+    // Same verdict as the move search
+    EXPECT_EQ(ai.findBestMove(game), analysis[0].move);
+}
+
+TEST_F(AITest, AnalyzeFindsWinDistance) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(0, 1); // O
+    game.makeMove(1, 1); // X
+    game.makeMove(2, 2); // O
+    // Board: X O .
+    //        . X .
+    //        . . O
+    // X has no immediate win but forks with (1,0) or (2,0), winning on ply 3
+    
+    AI ai(Player::X);
+    auto analysis = ai.analyze(game);
+    ASSERT_FALSE(analysis.empty());
+    EXPECT_EQ(MoveOutcome::WIN, analysis[0].outcome);
+    EXPECT_EQ(3, analysis[0].distance);
+}
+
+TEST_F(AITest, AnalyzeSharesTableAcrossMoves) {
+    Game game;
+    AI ai(Player::X);
+    auto analysis = ai.analyze(game);
+    const SearchStats& stats = ai.getLastSearchStats();
+    
+    EXPECT_EQ(9u, analysis.size());
+    for (const auto& entry : analysis) {
+        EXPECT_EQ(MoveOutcome::DRAW, entry.outcome); // Every first move draws
+    }
+    EXPECT_GT(stats.counters.ttHits, 0u); // Later moves reuse earlier subtrees
+    EXPECT_LT(stats.counters.nodes, 60000u);
+}
+
+TEST_F(AITest, BatchPlaysOptimalMoves) {
+    // Every position after two moves, plus exact duplicates of the first few
+    std::vector<Game> games;
+    Game empty;
+    for (const auto& first : empty.getAvailableMoves()) {
+        Game afterFirst = empty;
+        afterFirst.makeMove(first.first, first.second);
+        for (const auto& second : afterFirst.getAvailableMoves()) {
+            Game game = afterFirst;
+            game.makeMove(second.first, second.second);
+            games.push_back(game);
+        }
+    }
+    games.insert(games.end(), games.begin(), games.begin() + 8);
+
+    AI ai(Player::X);
+    auto moves = ai.findBestMoves(games);
+    ASSERT_EQ(games.size(), moves.size());
+
+    // Each batch move must be as good as the best move of a full analysis
+    AI reference(Player::X);
+    for (size_t i = 0; i < games.size(); ++i) {
+        auto analysis = reference.analyze(games[i]);
+        auto played = std::find_if(analysis.begin(), analysis.end(),
+                                   [&](const MoveAnalysis& a) { return a.move == moves[i]; });
+        ASSERT_NE(analysis.end(), played) << "illegal move in game " << i;
+        EXPECT_EQ(analysis.front().score, played->score) << "game " << i;
+    }
+
+    // Duplicates are answered without a second search
+    for (size_t i = 72; i < games.size(); ++i) {
+        EXPECT_EQ(moves[i - 72], moves[i]);
+    }
+    EXPECT_GT(ai.getLastSearchStats().counters.nodes, 0u);
+}
+
+TEST_F(AITest, BatchDeadlineStillAnswersEveryGame) {
+    // Noisy level: no deduplication, every game is searched
+    std::vector<Game> games(200);
+    for (size_t i = 0; i < games.size(); ++i) {
+        games[i].makeMove(static_cast<int>(i % 3), static_cast<int>(i / 3 % 3));
+    }
+
+    AI ai(Player::O, Difficulty::MEDIUM);
+    ai.setRandomSeed(7);
+    auto moves = ai.findBestMoves(games, std::chrono::milliseconds(1));
+    ASSERT_EQ(games.size(), moves.size());
+    for (size_t i = 0; i < games.size(); ++i) {
+        Game game = games[i];
+        EXPECT_TRUE(game.makeMove(moves[i].first, moves[i].second)) << "game " << i;
+    }
+}
+
+TEST_F(AITest, BatchHandlesFinishedAndEmptyInput) {
+    AI ai(Player::X);
+    EXPECT_TRUE(ai.findBestMoves({}).empty());
+
+    // Full board: no move available
+    Game full;
+    int order[9][2] = {{0, 0}, {0, 1}, {0, 2}, {1, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 0}, {2, 2}};
+    for (auto& cell : order) {
+        full.makeMove(cell[0], cell[1]);
+    }
+    auto moves = ai.findBestMoves({full, Game()});
+    ASSERT_EQ(2u, moves.size());
+    EXPECT_EQ(std::make_pair(-1, -1), moves[0]);
+    EXPECT_GE(moves[1].first, 0);
+}
+
+TEST_F(AITest, BatchWorkersShareTable) {
+    std::vector<Game> games;
+    for (int cell = 0; cell < 9; ++cell) {
+        Game game;
+        game.makeMove(cell / 3, cell % 3);
+        games.push_back(game);
+    }
+
+    AI ai(Player::O);
+    ai.findBestMoves(games);
+    std::uint64_t coldNodes = ai.getLastSearchStats().counters.nodes;
+
+    // The same batch again finds the first call's results in the table
+    ai.findBestMoves(games);
+    const SearchCounters& warm = ai.getLastSearchStats().counters;
+    EXPECT_GT(warm.ttHits, 0u);
+    EXPECT_LT(warm.nodes * 4, coldNodes);
+}
+
+TEST_F(AITest, SymmetricPositionsShareTable) {
+    // Rotated / mirrored copies hit the same table entries, which cuts the
+    // full-depth search of the empty board to well under 2000 nodes
+    AI ai(Player::X);
+    Game game;
+    ai.findBestMove(game);
+    const SearchStats& stats = ai.getLastSearchStats();
+    EXPECT_LT(stats.counters.nodes, 2000u);
+    EXPECT_GT(stats.ttHitRate(), 0.5);
+
+    // Stored moves are mapped back onto the searched board: the extended
+    // principal variation stays playable to the end
+    Game line;
+    for (const auto& move : stats.principalVariation) {
+        EXPECT_TRUE(line.makeMove(move.first, move.second));
+    }
+    EXPECT_TRUE(line.isDraw());
+}
+
+TEST_F(AITest, CacheCarriesAcrossMoves) {
+    // The second search of a position is answered mostly from the cache
+    AI ai(Player::X);
+    Game game;
+    game.makeMove(1, 1); // X
+    game.makeMove(0, 0); // O
+    
+    auto first = ai.findBestMove(game);
+    std::uint64_t coldNodes = ai.getLastSearchStats().counters.nodes;
+    auto second = ai.findBestMove(game);
+    std::uint64_t warmNodes = ai.getLastSearchStats().counters.nodes;
+
+    EXPECT_EQ(first, second);
+    EXPECT_LT(warmNodes * 4, coldNodes);
+
+    // Clearing forgets everything again
+    ai.clearCache();
+    ai.findBestMove(game);
+    EXPECT_EQ(coldNodes, ai.getLastSearchStats().counters.nodes);
+}
+
+TEST_F(AITest, CacheStaysWithinMemoryLimit) {
+    AI ai(Player::X);
+    ai.setCacheSize(8 * 1024);
+    EXPECT_LE(ai.getCacheSize(), 8u * 1024);
+    EXPECT_GT(ai.getCacheSize(), 0u);
+
+    // A tiny cache still gives perfect play over a whole session
+    AI opponent(Player::O);
+    for (int round = 0; round < 5; ++round) {
+        Game game;
+        while (game.getWinner() == Player::NONE && !game.isDraw()) {
+            AI& mover = (game.getCurrentPlayer() == Player::X) ? ai : opponent;
+            auto move = mover.findBestMove(game);
+            ASSERT_TRUE(game.makeMove(move.first, move.second));
+        }
+        EXPECT_TRUE(game.isDraw());
+    }
+
+    // Huge pages are a hint: the cache works whether or not the system has them
+    ai.setCacheSize(4 * 1024 * 1024, true);
+    EXPECT_LE(ai.getCacheSize(), 4u * 1024 * 1024);
+    EXPECT_EQ(std::make_pair(0, 0), ai.findBestMove(Game()));
+}
+
+TEST_F(AITest, CacheAgesOutOldEntries) {
+    // One bucket: every key competes for the same slots
+    TranspositionTable table(1);
+    ASSERT_EQ(TranspositionTable::BUCKET_SIZE, table.size());
+    for (std::uint32_t key = 1; key <= TranspositionTable::BUCKET_SIZE; ++key) {
+        table.store(key, 0, 9, Bound::EXACT, 4);
+    }
+
+    // Three searches later, deep but stale results give way to fresh shallow ones
+    table.newSearch();
+    table.newSearch();
+    table.newSearch();
+    table.store(10, 0, 2, Bound::EXACT, 4);
+    table.store(11, 0, 2, Bound::EXACT, 4);
+
+    TTEntry entry;
+    EXPECT_TRUE(table.probe(10, entry));
+    EXPECT_TRUE(table.probe(11, entry));
+    EXPECT_FALSE(table.probe(1, entry));
+    EXPECT_FALSE(table.probe(2, entry));
+    EXPECT_TRUE(table.probe(3, entry));
+    EXPECT_EQ(TranspositionTable::BUCKET_SIZE, table.occupied());
+}
+
+TEST_F(AITest, ClockedMoveKeepsLevelLimits) {
+    AI ai(Player::X);
+    GameClock clock(TimeControl{std::chrono::milliseconds(10000), std::chrono::milliseconds(1000)});
+    clock.start(Player::X);
+
+    Game game;
+    auto move = ai.findBestMove(game, clock);
+    EXPECT_EQ(Player::NONE, game.at(move.first, move.second));
+
+    // The clock budget only applies to that one move
+    EXPECT_EQ(0, ai.getLimits().maxTime.count());
+}
+
+TEST_F(AITest, ShortClockStillFindsWin) {
+    AI ai(Player::X);
+    GameClock clock(TimeControl{std::chrono::milliseconds(10000), std::chrono::milliseconds(0)});
+    clock.start(Player::X, GameClock::Clock::now() - std::chrono::milliseconds(9990));
+
+    // X O .
+    // X O .
+    // . . .   X to move with ~10 ms left wins at (2, 0)
+    Game game;
+    game.makeMove(0, 0); game.makeMove(0, 1);
+    game.makeMove(1, 0); game.makeMove(1, 1);
+
+    auto start = std::chrono::steady_clock::now();
+    auto move = ai.findBestMove(game, clock);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(std::make_pair(2, 0), move);
+    EXPECT_LT(elapsed, std::chrono::milliseconds(200));
+}
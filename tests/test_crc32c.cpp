@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "Crc32c.h"
+#include <string>
+#include <vector>
+
+namespace {
+    using Extend = std::uint32_t (*)(std::uint32_t, const void*, std::size_t);
+
+    // Both implementations: 'extend' (hardware where the CPU has it) and the table
+    const Extend IMPLEMENTATIONS[] = {Crc32c::extend, Crc32c::extendSoftware};
+}
+
+TEST(Crc32cTest, KnownValues) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // The SSE4.2 path is always built and picked whenever the CPU has it
+    EXPECT_EQ(__builtin_cpu_supports("sse4.2") != 0, Crc32c::usesHardware());
+#endif
+
+    std::vector<unsigned char> zeros(32, 0x00), ones(32, 0xFF), ascending(32);
+    for (int i = 0; i < 32; ++i) {
+        ascending[i] = static_cast<unsigned char>(i);
+    }
+    for (Extend extend : IMPLEMENTATIONS) {
+        // Check values from RFC 3720, appendix B.4
+        EXPECT_EQ(0xE3069283u, extend(0, "123456789", 9));
+        EXPECT_EQ(0u, extend(0, "", 0));
+        EXPECT_EQ(0x8A9136AAu, extend(0, zeros.data(), zeros.size()));
+        EXPECT_EQ(0x62A8AB43u, extend(0, ones.data(), ones.size()));
+        EXPECT_EQ(0x46DD794Eu, extend(0, ascending.data(), ascending.size()));
+    }
+    EXPECT_EQ(0xE3069283u, Crc32c::compute("123456789", 9));
+}
+
+TEST(Crc32cTest, ExtendMatchesOneShot) {
+    std::string text = "The quick brown fox jumps over the lazy dog, twice over";
+    std::uint32_t whole = Crc32c::compute(text.data(), text.size());
+    EXPECT_EQ(whole, Crc32c::extendSoftware(0, text.data(), text.size()));
+
+    // Every split point, covering unaligned heads and short tails
+    for (Extend extend : IMPLEMENTATIONS) {
+        for (std::size_t split = 0; split <= text.size(); ++split) {
+            std::uint32_t crc = extend(0, text.data(), split);
+            crc = extend(crc, text.data() + split, text.size() - split);
+            EXPECT_EQ(whole, crc) << "split at " << split;
+        }
+    }
+
+    // Any flipped bit changes the CRC
+    text[10] ^= 0x04;
+    EXPECT_NE(whole, Crc32c::compute(text.data(), text.size()));
+}
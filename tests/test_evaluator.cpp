@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "Evaluator.h"           // Functions under test
+#include "AI.h"                  // Search integration
+
+TEST(EvaluatorTest, EmptyBoardIsEven) {
+    EXPECT_EQ(0, Evaluator::evaluate(0, 0));
+}
+
+TEST(EvaluatorTest, CenterBeatsCornerBeatsEdge) {
+    int center = Evaluator::evaluate(0x010, 0);  // (1,1): 4 lines
+    int corner = Evaluator::evaluate(0x001, 0);  // (0,0): 3 lines
+    int edge = Evaluator::evaluate(0x002, 0);    // (0,1): 2 lines
+    EXPECT_GT(center, corner);
+    EXPECT_GT(corner, edge);
+    EXPECT_EQ(2, edge);
+}
+
+TEST(EvaluatorTest, OpenTwoInARow) {
+    // Own (0,0),(0,1) against an opponent far away on (2,2)
+    int open = Evaluator::evaluate(0x003, 0x100);
+    // Same marks with the row blocked on (0,2)
+    int blocked = Evaluator::evaluate(0x003, 0x004);
+    EXPECT_GT(open, blocked);
+}
+
+TEST(EvaluatorTest, Antisymmetric) {
+    // Swapping the sides negates the score, for every legal placement of marks
+    for (std::uint16_t mine = 0; mine < 512; ++mine) {
+        for (std::uint16_t theirs = 0; theirs < 512; ++theirs) {
+            if (mine & theirs) continue;
+            ASSERT_EQ(-Evaluator::evaluate(mine, theirs), Evaluator::evaluate(theirs, mine));
+        }
+    }
+}
+
+TEST(EvaluatorTest, MatchesScalarReference) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // The SSSE3 path is always built and picked whenever the CPU has SSSE3
+    EXPECT_EQ(__builtin_cpu_supports("ssse3") != 0, Evaluator::usesSimd());
+#endif
+
+    for (std::uint16_t mine = 0; mine < 512; ++mine) {
+        for (std::uint16_t theirs = 0; theirs < 512; ++theirs) {
+            if (mine & theirs) continue;
+            ASSERT_EQ(Evaluator::evaluateScalar(mine, theirs), Evaluator::evaluate(mine, theirs))
+                << "mine=" << mine << " theirs=" << theirs;
+        }
+    }
+}
+
+TEST(EvaluatorTest, ShallowSearchUsesEvaluation) {
+    // At depth 1 every move reaches the horizon, so only the static evaluation
+    // tells the moves apart: the center is worth the most
+    SearchLimits limits;
+    limits.maxDepth = 1;
+    AI ai(Player::X, limits);
+    Game game;
+
+    auto move = ai.findBestMove(game);
+    EXPECT_EQ(1, move.first);
+    EXPECT_EQ(1, move.second);
+}
@@ -162,4 +162,32 @@ TEST_F(GameTest, PlayerAlternation) {
     // Failed move shouldn't change current player
     EXPECT_FALSE(game.makeMove(0, 0)); // Already occupied
     EXPECT_EQ(Player::O, game.getCurrentPlayer()); // Should still be O's turn
-}
\ No newline at end of file
+}
+
+TEST_F(GameTest, FlagFallAwardsOpponent) {
+    game.makeMove(1, 1);
+    game.flagFall(Player::O);
+
+    EXPECT_EQ(Player::O, game.getFlagged());
+    EXPECT_EQ(Player::X, game.getWinner());
+    EXPECT_FALSE(game.isDraw());
+
+    // No moves once the game is over on time
+    EXPECT_FALSE(game.makeMove(0, 0));
+    EXPECT_EQ(Player::NONE, game.at(0, 0));
+
+    game.reset();
+    EXPECT_EQ(Player::NONE, game.getFlagged());
+    EXPECT_TRUE(game.makeMove(0, 0));
+}
+
+TEST_F(GameTest, FlagFallAfterGameEndIsIgnored) {
+    // X wins the top row before O's time runs out
+    game.makeMove(0, 0); game.makeMove(1, 0);
+    game.makeMove(0, 1); game.makeMove(1, 1);
+    game.makeMove(0, 2);
+
+    game.flagFall(Player::X);
+    EXPECT_EQ(Player::NONE, game.getFlagged());
+    EXPECT_EQ(Player::X, game.getWinner());
+}
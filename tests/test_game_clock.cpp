@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "GameClock.h"
+
+using std::chrono::milliseconds;
+
+class GameClockTest : public ::testing::Test {
+protected:
+    // Fixed reference point; every call passes its own time
+    GameClock::Clock::time_point t0 = GameClock::Clock::now();
+    TimeControl control{milliseconds(10000), milliseconds(1000)};
+};
+
+TEST_F(GameClockTest, OnlyRunningSideLosesTime) {
+    GameClock clock(control);
+    clock.start(Player::X, t0);
+
+    EXPECT_EQ(Player::X, clock.running());
+    EXPECT_EQ(7000, clock.remaining(Player::X, t0 + milliseconds(3000)).count());
+    EXPECT_EQ(10000, clock.remaining(Player::O, t0 + milliseconds(3000)).count());
+}
+
+TEST_F(GameClockTest, PressAddsIncrementAndSwitchesSides) {
+    GameClock clock(control);
+    clock.start(Player::X, t0);
+
+    EXPECT_TRUE(clock.press(t0 + milliseconds(3000)));
+    EXPECT_EQ(Player::O, clock.running());
+    EXPECT_EQ(8000, clock.remaining(Player::X, t0 + milliseconds(5000)).count());
+    EXPECT_EQ(8000, clock.remaining(Player::O, t0 + milliseconds(5000)).count());
+
+    clock.stop(t0 + milliseconds(5000));
+    EXPECT_EQ(Player::NONE, clock.running());
+    EXPECT_EQ(8000, clock.remaining(Player::O, t0 + milliseconds(60000)).count());
+}
+
+TEST_F(GameClockTest, FlagFallsWhenTimeRunsOut) {
+    GameClock clock(control);
+    clock.start(Player::X, t0);
+
+    EXPECT_EQ(Player::NONE, clock.flagged(t0 + milliseconds(9999)));
+    EXPECT_EQ(Player::X, clock.flagged(t0 + milliseconds(10000)));
+    EXPECT_EQ(0, clock.remaining(Player::X, t0 + milliseconds(12000)).count());
+
+    // A late press earns no increment
+    EXPECT_FALSE(clock.press(t0 + milliseconds(12000)));
+    EXPECT_EQ(Player::X, clock.flagged(t0 + milliseconds(12000)));
+}
+
+TEST_F(GameClockTest, UntimedClockNeverFlags) {
+    GameClock clock;
+    clock.start(Player::X, t0);
+
+    EXPECT_FALSE(clock.getControl().isTimed());
+    EXPECT_EQ(Player::NONE, clock.running());
+    EXPECT_EQ(Player::NONE, clock.flagged(t0 + milliseconds(3600000)));
+    EXPECT_TRUE(clock.press(t0 + milliseconds(3600000)));
+}
+
+TEST_F(GameClockTest, FormatsTimes) {
+    EXPECT_EQ("1:05", GameClock::format(milliseconds(65000)));
+    EXPECT_EQ("0:10", GameClock::format(milliseconds(10000)));
+    EXPECT_EQ("0:09.3", GameClock::format(milliseconds(9350)));
+    EXPECT_EQ("0:00.0", GameClock::format(milliseconds(-20)));
+
+    EXPECT_EQ("10s + 1s", control.toString());
+    EXPECT_EQ("1 min", (TimeControl{milliseconds(60000), milliseconds(0)}).toString());
+    EXPECT_EQ("Untimed", TimeControl().toString());
+}
+
+TEST_F(GameClockTest, BudgetFollowsGamePhase) {
+    Game game;
+    milliseconds opening = TimeManager::moveBudget(game, milliseconds(10000), milliseconds(0));
+
+    // Five X moves to make from the empty board: roughly a fifth of the time
+    EXPECT_GT(opening.count(), 1500);
+    EXPECT_LE(opening.count(), 2000);
+
+    // Later moves get a larger share of what is left
+    game.makeMove(0, 0); game.makeMove(1, 1);
+    game.makeMove(2, 2); game.makeMove(0, 2);
+    milliseconds middle = TimeManager::moveBudget(game, milliseconds(10000), milliseconds(0));
+    EXPECT_GT(middle, opening);
+}
+
+TEST_F(GameClockTest, BudgetStaysWithinClock) {
+    Game game;
+    for (int remaining : {1, 5, 40, 200, 3000}) {
+        for (int increment : {0, 1000, 5000}) {
+            milliseconds budget = TimeManager::moveBudget(game, milliseconds(remaining),
+                                                          milliseconds(increment));
+            EXPECT_GE(budget.count(), 1);
+            EXPECT_LE(budget.count(), std::max(1, remaining));
+        }
+    }
+
+    // The increment is mostly spent, since it comes back after the move
+    EXPECT_GT(TimeManager::moveBudget(game, milliseconds(10000), milliseconds(1000)),
+              TimeManager::moveBudget(game, milliseconds(10000), milliseconds(0)));
+
+    // Out of time: the smallest possible budget
+    EXPECT_EQ(1, TimeManager::moveBudget(game, milliseconds(0), milliseconds(1000)).count());
+}
@@ -1,28 +1,48 @@
 #include <gtest/gtest.h>         // Google Test framework
 #include "History.h"             // Class under test
+#include "HistoryStore.h"        // Where histories are stored
+#include "Leaderboard.h"         // Updated as games are stored
 #include <filesystem>           // For deleting test files
 #include <fstream>              // File I/O for manual result file creation
 #include <vector>               // To track and compare results
 #include <chrono>               // Used in performance test
+#include <cstdlib>              // For setenv / getenv
+#include <ctime>                // For time / tzset
 
 class HistoryTest : public ::testing::Test {
 protected:
     std::vector<std::string> testFiles; // Track test files for cleanup
+    std::vector<std::string> users;     // Users whose history is deleted after the test
+
+    // Every test stores into an empty directory of its own
+    const std::string directory = (std::filesystem::temp_directory_path() / "tictactoe_history_test").string();
+    HistoryStore store{directory};
 
     void SetUp() override {
-        // Setup for each test
+        std::filesystem::remove_all(directory); // Leftovers of an interrupted run
     }
     
     void TearDown() override {
         // Clean up test files
         cleanupTestFiles();
+        std::filesystem::remove_all(directory);
     }
 
     void addTestFile(const std::string& filename) {
         testFiles.push_back(filename);
     }
 
+    // The user's games in the store and any files of older versions
+    void addUserFiles(const std::string& username) {
+        History::remove(username, &store); // Leftovers of an interrupted run
+        users.push_back(username);
+    }
+
     void cleanupTestFiles() {
+        for (const auto& username : users) {
+            History::remove(username, &store);
+        }
+        users.clear();
         for (const auto& filename : testFiles) {
             if (std::filesystem::exists(filename)) {
                 std::filesystem::remove(filename);
@@ -40,52 +60,54 @@ protected:
 // Just testing creation of History objects for different usernames
 TEST_F(HistoryTest, Initialization) {
     // Test history initialization with different usernames
-    History history1("testuser1");
-    addTestFile("history_testuser1.txt");
+    History history1("testuser1", nullptr, &store);
+    addUserFiles("testuser1");
     SUCCEED(); // If we get here, initialization worked
     
-    History history2("testuser2");
-    addTestFile("history_testuser2.txt");
+    History history2("testuser2", nullptr, &store);
+    addUserFiles("testuser2");
     SUCCEED(); // If we get here, initialization worked
     
     // Test with special characters in username
-    History history3("test_user-123");
-    addTestFile("history_test_user-123.txt");
+    History history3("test_user-123", nullptr, &store);
+    addUserFiles("test_user-123");
     SUCCEED(); // If we get here, initialization worked
 }
 
 TEST_F(HistoryTest, SaveSingleResult) {
     std::string username = "single_test_user";
-    std::string expectedFile = "history_" + username + ".txt";
-    addTestFile(expectedFile);
+    std::string expectedFile = store.shardPath(username);
+    addUserFiles(username);
     
-    History history(username);
+    History history(username, nullptr, &store);
     
     // Test saving a single game result
     GameResult result1 = {"2024-01-15 10:30:00", "Win"};
     history.saveResult(result1);
     
-    // Check that file was created
+    // Check that the user's shard was created, and no per-user file
     EXPECT_TRUE(fileExists(expectedFile));
+    EXPECT_FALSE(fileExists("history_" + username + ".bin"));
+    EXPECT_FALSE(fileExists("history_" + username + ".txt"));
     
     // Check file contents
-    std::ifstream file(expectedFile);
-    std::string line;
-    bool foundResult = false;
-    if (std::getline(file, line)) {
-        foundResult = (line == "2024-01-15 10:30:00,Win");
-    }
+    std::ifstream file(expectedFile, std::ios::binary);
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
     file.close();
+    EXPECT_EQ("TTTD", std::string(magic, sizeof(magic)));
     
-    EXPECT_TRUE(foundResult);
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(1u, loaded.size());
+    EXPECT_EQ("2024-01-15 10:30:00", loaded[0].date);
+    EXPECT_EQ("Win", loaded[0].result);
 }
 
 TEST_F(HistoryTest, SaveMultipleResults) {
     std::string username = "multiple_test_user";
-    std::string expectedFile = "history_" + username + ".txt";
-    addTestFile(expectedFile);
+    addUserFiles(username);
     
-    History history(username);
+    History history(username, nullptr, &store);
     
     // Test saving multiple game results
     std::vector<GameResult> results = {
@@ -99,14 +121,11 @@ TEST_F(HistoryTest, SaveMultipleResults) {
         history.saveResult(result);
     }
     
-    // Check file contents
-    std::ifstream file(expectedFile);
+    // Check file contents, in the order they were saved
     std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(file, line)) {
-        lines.push_back(line);
+    for (const auto& result : History(username, nullptr, &store).loadHistory()) {
+        lines.push_back(result.date + "," + result.result);
     }
-    file.close();
     
     EXPECT_EQ(4, lines.size());
     EXPECT_EQ("2024-01-15 10:30:00,Win", lines[0]);
@@ -118,16 +137,16 @@ TEST_F(HistoryTest, SaveMultipleResults) {
 TEST_F(HistoryTest, LoadHistory) {
     std::string username = "load_test_user";
     std::string expectedFile = "history_" + username + ".txt";
-    addTestFile(expectedFile);
+    addUserFiles(username);
     
-    // Create test data file manually
+    // Create test data file manually (text format of older versions)
     std::ofstream file(expectedFile);
     file << "2024-01-15 10:30:00,Win\n";
     file << "2024-01-15 11:45:00,Loss\n";
     file << "2024-01-15 14:20:00,Draw\n";
     file.close();
     
-    History history(username);
+    History history(username, nullptr, &store);
     std::vector<GameResult> loadedHistory = history.loadHistory();
     
     EXPECT_EQ(3, loadedHistory.size());
@@ -144,8 +163,8 @@ TEST_F(HistoryTest, LoadHistory) {
 
 TEST_F(HistoryTest, LoadEmptyHistory) {
     std::string username = "empty_test_user";
-    History history(username);
-    addTestFile("history_" + username + ".txt");
+    History history(username, nullptr, &store);
+    addUserFiles(username);
     
     // Try to load history when no file exists
     std::vector<GameResult> loadedHistory = history.loadHistory();
@@ -157,9 +176,9 @@ TEST_F(HistoryTest, LoadEmptyHistory) {
 //This is a data persistence test simulating what happens if the app shuts down and restarts
 TEST_F(HistoryTest, SaveAndLoadRoundTrip) {
     std::string username = "roundtrip_test_user";
-    addTestFile("history_" + username + ".txt");
+    addUserFiles(username);
     
-    History history(username);
+    History history(username, nullptr, &store);
     
     // Create test data
     std::vector<GameResult> originalResults = {
@@ -189,9 +208,9 @@ TEST_F(HistoryTest, SaveAndLoadRoundTrip) {
 
 TEST_F(HistoryTest, LargeHistoryFile) {
     std::string username = "large_test_user";
-    addTestFile("history_" + username + ".txt");
+    addUserFiles(username);
     
-    History history(username);
+    History history(username, nullptr, &store);
     
     // Create a large number of entries
     const int numEntries = 1000;
@@ -224,4 +243,667 @@ TEST_F(HistoryTest, LargeHistoryFile) {
     EXPECT_EQ(numEntries, loadedHistory.size());
     EXPECT_LT(loadDuration.count(), 1000); // Loading should complete in under 1 second
     EXPECT_LT(saveDuration.count(), 5000);  // Saving should complete in under 5 seconds
-}
\ No newline at end of file
+}
+TEST_F(HistoryTest, MigratesTextHistory) {
+    std::string username = "migrate_test_user";
+    addUserFiles(username);
+
+    // Results as older versions of the windows wrote them
+    std::ofstream file("history_" + username + ".txt");
+    file << "2024-02-01 09:00:00,You win! 🎉\n";
+    file << "2024-02-01 09:05:00,AI wins! 🤖\n";
+    file << "2024-02-01 09:10:00,It's a draw! 🤝\n";
+    file << "2024-02-02 18:00:00,migrate_test_user wins! 🎉\n";
+    file << "2024-02-02 18:05:00,Bob wins! 🎉\n";
+    file.close();
+
+    History history(username, nullptr, &store);
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(5u, loaded.size());
+    EXPECT_EQ("Win", loaded[0].result);
+    EXPECT_EQ("Loss", loaded[1].result);
+    EXPECT_EQ("Draw", loaded[2].result);
+    EXPECT_EQ("Win", loaded[3].result);
+    EXPECT_EQ("Loss", loaded[4].result);
+    EXPECT_EQ("2024-02-02 18:05:00", loaded[4].date);
+
+    // The text file is kept aside, and new games go to the store only
+    EXPECT_FALSE(fileExists("history_" + username + ".txt"));
+    EXPECT_TRUE(fileExists("history_" + username + ".txt.migrated"));
+    history.saveResult({"2024-02-03 08:00:00", "Draw"});
+    EXPECT_EQ(6u, History(username, nullptr, &store).loadHistory().size());
+    EXPECT_TRUE(history.verify());
+}
+
+TEST_F(HistoryTest, KeepsModeAndOpponent) {
+    std::string username = "fields_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    GameResult result = {"2024-03-01 12:00:00", "Loss"};
+    result.mode = HistoryMode::PLAYER;
+    result.opponent = History::opponentId("Bob");
+    history.saveResult(result);
+
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(1u, loaded.size());
+    EXPECT_EQ(HistoryMode::PLAYER, loaded[0].mode);
+    EXPECT_EQ(History::opponentId("Bob"), loaded[0].opponent);
+    EXPECT_NE(0, loaded[0].opponent);
+    EXPECT_EQ(0, History::opponentId(""));
+}
+
+TEST_F(HistoryTest, IgnoresTornAppend) {
+    std::string username = "torn_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-01-15 10:30:00", "Win"});
+    history.saveResult({"2024-01-15 11:30:00", "Loss"});
+
+    // A crash mid-append leaves bytes past the end the header knows about
+    {
+        std::ofstream out(store.shardPath(username), std::ios::binary | std::ios::app);
+        out.write("\x01\x02\x03\x04\x05", 5);
+    }
+    EXPECT_EQ(2u, history.loadHistory().size());
+    EXPECT_TRUE(history.verify());
+
+    // The next game overwrites the torn bytes
+    history.saveResult({"2024-01-15 12:30:00", "Draw"});
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(3u, loaded.size());
+    EXPECT_EQ("Draw", loaded[2].result);
+    EXPECT_TRUE(history.verify());
+}
+
+TEST_F(HistoryTest, RecoversFromTruncatedShard) {
+    std::string username = "truncated_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-01-15 10:30:00", "Win"});
+    history.saveResult({"2024-01-15 11:30:00", "Loss"});
+
+    // A crash mid-append leaves the file ending partway through the last frame
+    std::string path = store.shardPath(username);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+    EXPECT_EQ(1u, history.count());
+
+    // Later games are still stored after the last intact one
+    EXPECT_TRUE(history.saveResult({"2024-01-15 12:30:00", "Draw"}));
+    EXPECT_TRUE(history.saveResult({"2024-01-15 13:30:00", "Win"}));
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(3u, loaded.size());
+    EXPECT_EQ("Win", loaded[0].result);
+    EXPECT_EQ("Draw", loaded[1].result);
+    EXPECT_EQ(3u, history.getStats().total.games);
+    EXPECT_TRUE(history.verify());
+}
+
+TEST_F(HistoryTest, ReportsUnstoredResult) {
+    // A store below a regular file can never be created, whoever runs the test
+    std::filesystem::create_directories(directory);
+    std::string blocker = directory + "/not_a_directory";
+    std::ofstream(blocker) << "x";
+    HistoryStore unwritable(blocker + "/history");
+
+    History history("unstored_test_user", nullptr, &unwritable);
+    EXPECT_FALSE(history.saveResult({"2024-01-15 10:30:00", "Win"}));
+    EXPECT_EQ(0u, history.count());
+
+    History working("stored_test_user", nullptr, &store);
+    addUserFiles("stored_test_user");
+    EXPECT_TRUE(working.saveResult({"2024-01-15 10:30:00", "Win"}));
+}
+
+TEST_F(HistoryTest, DetectsDamagedRecords) {
+    std::string username = "damaged_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-01-15 10:30:00", "Win"});
+    history.saveResult({"2024-01-16 10:30:00", "Win"});
+    EXPECT_TRUE(history.verify());
+
+    // Flip the outcome byte of the first record, found by its timestamp (the
+    // stats only hold the latest one; earlier runs may have left older copies)
+    std::int64_t timestamp = 0;
+    ASSERT_TRUE(History::parseDate("2024-01-15 10:30:00", timestamp));
+    std::string path = store.shardPath(username);
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::size_t at = bytes.rfind(std::string(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp)));
+    ASSERT_NE(std::string::npos, at);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(at + 8));
+        file.put(static_cast<char>(GameOutcome::LOSS));
+    }
+    EXPECT_FALSE(history.verify());
+}
+
+TEST_F(HistoryTest, DatesRoundTrip) {
+    std::int64_t timestamp = 0, later = 0;
+    ASSERT_TRUE(History::parseDate("2024-06-10 08:00:00", timestamp));
+    ASSERT_TRUE(History::parseDate("2024-06-11 08:00:01", later));
+    EXPECT_EQ(86401, later - timestamp);
+
+    for (const std::string date : {"2024-02-29 23:59:59", "1999-12-31 00:00:00", "2100-03-01 12:34:56"}) {
+        ASSERT_TRUE(History::parseDate(date, timestamp));
+        EXPECT_EQ(date, History::formatDate(timestamp));
+    }
+
+    // Day-only dates read as midnight
+    ASSERT_TRUE(History::parseDate("2024-01-05", timestamp));
+    EXPECT_EQ("2024-01-05 00:00:00", History::formatDate(timestamp));
+
+    EXPECT_FALSE(History::parseDate("", timestamp));
+    EXPECT_FALSE(History::parseDate("yesterday", timestamp));
+    EXPECT_FALSE(History::parseDate("2024-13-01 00:00:00", timestamp));
+
+    // Now is UTC, like stored times
+    EXPECT_NEAR(static_cast<double>(std::time(nullptr)), static_cast<double>(History::currentTime()), 2.0);
+}
+
+#ifndef _WIN32
+TEST_F(HistoryTest, StoresUtcAcrossDaylightSavingEnd) {
+    // US Eastern time, set by rule so no time zone database is needed; the
+    // previous zone comes back however the test ends
+    struct TimeZone {
+        bool hadZone;
+        std::string previous;
+
+        explicit TimeZone(const char* zone) : hadZone(std::getenv("TZ") != nullptr) {
+            if (hadZone) previous = std::getenv("TZ");
+            setenv("TZ", zone, 1);
+            tzset();
+        }
+        ~TimeZone() {
+            if (hadZone) {
+                setenv("TZ", previous.c_str(), 1);
+            } else {
+                unsetenv("TZ");
+            }
+            tzset();
+        }
+    } eastern("EST5EDT,M3.2.0,M11.1.0");
+
+    std::int64_t summer = 0;
+    ASSERT_TRUE(History::parseDate("2024-07-01 12:00:00", summer));
+    EXPECT_EQ(1719849600, summer);  // 16:00 UTC
+
+    // 2024-11-03 05:30 and 06:30 UTC are both 01:30 local. Games played
+    // then are stored an hour apart, in order, and shown at local time.
+    std::string username = "dst_user";
+    addUserFiles(username);
+    History history(username, nullptr, &store);
+    std::int64_t first = 1730611800;
+    for (std::int64_t timestamp : {first, first + 3600}) {
+        HistoryRecord record;
+        record.timestamp = timestamp;
+        record.outcome = static_cast<std::uint8_t>(GameOutcome::WIN);
+        record.mode = static_cast<std::uint8_t>(HistoryMode::PLAYER);
+        record.opponent = 0;
+        record.moveOffset = HistoryRecord::NO_MOVES;
+        ASSERT_TRUE(store.append(username, {record}));
+    }
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(2u, loaded.size());
+    EXPECT_EQ("2024-11-03 01:30:00", loaded[0].date);
+    EXPECT_EQ("2024-11-03 01:30:00", loaded[1].date);
+    EXPECT_EQ(first, history.reader().record(0).timestamp);
+    EXPECT_EQ(first + 3600, history.reader().record(1).timestamp);
+}
+#endif
+
+TEST_F(HistoryTest, LoadsPagesAndLatest) {
+    std::string username = "paging_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    EXPECT_EQ(0u, history.count());
+    EXPECT_TRUE(history.loadLatest(20).empty());
+
+    // Game i is played on day i + 1 of January
+    for (int i = 0; i < 25; ++i) {
+        std::string day = (i + 1 < 10 ? "0" : "") + std::to_string(i + 1);
+        history.saveResult({"2024-01-" + day + " 12:00:00", i % 2 == 0 ? "Win" : "Loss"});
+    }
+    EXPECT_EQ(25u, history.count());
+
+    auto page = history.loadRange(10, 5);
+    ASSERT_EQ(5u, page.size());
+    EXPECT_EQ("2024-01-11 12:00:00", page.front().date);
+    EXPECT_EQ("2024-01-15 12:00:00", page.back().date);
+
+    // Pages past the end are cut short or empty
+    EXPECT_EQ(3u, history.loadRange(22, 10).size());
+    EXPECT_TRUE(history.loadRange(25, 10).empty());
+
+    auto latest = history.loadLatest(20);
+    ASSERT_EQ(20u, latest.size());
+    EXPECT_EQ("2024-01-06 12:00:00", latest.front().date);
+    EXPECT_EQ("2024-01-25 12:00:00", latest.back().date);
+    EXPECT_EQ(25u, history.loadLatest(100).size());
+}
+
+TEST_F(HistoryTest, StreamsBothWays) {
+    std::string username = "stream_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-01-01 10:00:00", "Win"});
+    history.saveResult({"2024-01-02 10:00:00", "Loss"});
+    history.saveResult({"2024-01-03 10:00:00", "Draw"});
+
+    HistoryReader games = history.reader();
+    ASSERT_EQ(3u, games.size());
+
+    std::vector<std::string> forward;
+    for (const GameResult& result : games) {
+        forward.push_back(result.result);
+    }
+    EXPECT_EQ((std::vector<std::string>{"Win", "Loss", "Draw"}), forward);
+
+    std::vector<std::string> backward;
+    for (auto it = games.rbegin(); it != games.rend(); ++it) {
+        backward.push_back((*it).result);
+    }
+    EXPECT_EQ((std::vector<std::string>{"Draw", "Loss", "Win"}), backward);
+
+    // The reader is a snapshot: later games need a new one
+    history.saveResult({"2024-01-04 10:00:00", "Win"});
+    EXPECT_EQ(3u, games.size());
+    EXPECT_EQ(4u, history.reader().size());
+
+    // Missing history streams nothing
+    HistoryReader none = History("stream_missing_user", nullptr, &store).reader();
+    EXPECT_TRUE(none.empty());
+    EXPECT_TRUE(none.begin() == none.end());
+}
+
+TEST_F(HistoryTest, StatsFollowSavedGames) {
+    std::string username = "stats_test_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    EXPECT_EQ(0u, history.getStats().total.games);
+
+    // W W W L D W W, the last two against the hard AI
+    const char* outcomes[] = {"Win", "Win", "Win", "Loss", "Draw", "Win", "Win"};
+    for (int i = 0; i < 7; ++i) {
+        GameResult result = {"2024-05-0" + std::to_string(i + 1) + " 20:00:00", outcomes[i]};
+        result.mode = i < 5 ? HistoryMode::PLAYER : HistoryMode::AI_HARD;
+        history.saveResult(result);
+    }
+
+    HistoryStats stats = history.getStats();
+    EXPECT_EQ(7u, stats.total.games);
+    EXPECT_EQ(5u, stats.total.wins);
+    EXPECT_EQ(1u, stats.total.losses);
+    EXPECT_EQ(1u, stats.total.draws);
+    EXPECT_NEAR(5.0 / 7.0, stats.total.winRate(), 1e-9);
+    EXPECT_EQ(5u, stats.forMode(HistoryMode::PLAYER).games);
+    EXPECT_EQ(2u, stats.forMode(HistoryMode::AI_HARD).wins);
+    EXPECT_EQ(0u, stats.forMode(HistoryMode::AI_EASY).games);
+    EXPECT_EQ(2, stats.currentStreak);
+    EXPECT_EQ(3u, stats.bestWinStreak);
+    EXPECT_EQ("2024-05-07 20:00:00", History::formatDate(stats.lastPlayed));
+
+    // Persisted: a new History object reads the same summary
+    EXPECT_EQ(7u, History(username, nullptr, &store).getStats().gamesCounted);
+
+    history.saveResult({"2024-05-08 20:00:00", "Loss"});
+    history.saveResult({"2024-05-09 20:00:00", "Loss"});
+    EXPECT_EQ(-2, history.getStats().currentStreak);
+}
+
+TEST_F(HistoryTest, StatsMatchRecount) {
+    std::string username = "stats_recount_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    for (int i = 0; i < 40; ++i) {
+        GameResult result = {"2024-01-01 10:00:00", i % 5 == 0 ? "Draw" : i % 3 == 0 ? "Loss" : "Win"};
+        result.mode = i % 2 == 0 ? HistoryMode::AI_MEDIUM : HistoryMode::PLAYER;
+        history.saveResult(result);
+    }
+
+    // The summary kept by the store equals one counted from the records
+    HistoryStats counted;
+    HistoryReader games = history.reader();
+    for (auto it = games.begin(); it != games.end(); ++it) {
+        counted.add(it.record());
+    }
+    HistoryStats stats = history.getStats();
+    EXPECT_EQ(counted.gamesCounted, stats.gamesCounted);
+    EXPECT_EQ(counted.total.wins, stats.total.wins);
+    EXPECT_EQ(counted.total.losses, stats.total.losses);
+    EXPECT_EQ(counted.forMode(HistoryMode::AI_MEDIUM).draws, stats.forMode(HistoryMode::AI_MEDIUM).draws);
+    EXPECT_EQ(counted.currentStreak, stats.currentStreak);
+    EXPECT_EQ(counted.bestWinStreak, stats.bestWinStreak);
+}
+
+TEST_F(HistoryTest, MigratesBinaryHistory) {
+    std::string username = "migrate_binary_user";
+    addUserFiles(username);
+
+    // A per-user file as the previous version wrote it: header, then records
+    // stamped with local wall-clock time (2024-04-0N 08:00:00)
+    std::vector<HistoryRecord> records;
+    for (int i = 0; i < 3; ++i) {
+        HistoryRecord record;
+        record.timestamp = 1711958400 + i * 86400;
+        record.outcome = static_cast<std::uint8_t>(i == 1 ? GameOutcome::LOSS : GameOutcome::WIN);
+        record.mode = static_cast<std::uint8_t>(HistoryMode::AI_EASY);
+        record.opponent = 0;
+        record.moveOffset = HistoryRecord::NO_MOVES;
+        records.push_back(record);
+    }
+    {
+        std::ofstream out("history_" + username + ".bin", std::ios::binary);
+        std::uint16_t version = 1, recordSize = sizeof(HistoryRecord);
+        std::uint32_t count = static_cast<std::uint32_t>(records.size()), checksum = 0;
+        out.write("TTTH", 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(HistoryRecord));
+    }
+
+    History history(username, nullptr, &store);
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(3u, loaded.size());
+    EXPECT_EQ("2024-04-01 08:00:00", loaded[0].date);
+    EXPECT_EQ("Loss", loaded[1].result);
+    EXPECT_EQ(HistoryMode::AI_EASY, loaded[2].mode);
+    EXPECT_EQ(2u, history.getStats().total.wins);
+
+    // Moved once: a second History does not import it again
+    EXPECT_FALSE(fileExists("history_" + username + ".bin"));
+    EXPECT_TRUE(fileExists("history_" + username + ".bin.migrated"));
+    EXPECT_EQ(3u, History(username, nullptr, &store).count());
+}
+
+TEST_F(HistoryTest, ManyUsersShareShards) {
+    // More users than shards, so shards hold several users and their
+    // indexes and record regions grow
+    const int userCount = HistoryStore::SHARD_COUNT * 3;
+    for (int user = 0; user < userCount; ++user) {
+        std::string username = "shard_user_" + std::to_string(user);
+        addUserFiles(username);
+        History history(username, nullptr, &store);
+        for (int game = 0; game <= user % 40; ++game) {
+            history.saveResult({"2024-07-01 10:00:00", game % 2 == 0 ? "Win" : "Loss"});
+        }
+    }
+
+    for (int user = 0; user < userCount; ++user) {
+        History history("shard_user_" + std::to_string(user), nullptr, &store);
+        std::size_t games = static_cast<std::size_t>(user % 40 + 1);
+        ASSERT_EQ(games, history.count()) << "user " << user;
+        EXPECT_EQ(games, history.getStats().gamesCounted);
+        EXPECT_EQ((games + 1) / 2, history.getStats().total.wins);
+        EXPECT_TRUE(history.verify());
+    }
+}
+
+TEST_F(HistoryTest, RemoveForgetsUser) {
+    std::string username = "remove_test_user";
+    std::string neighbour = "remove_test_neighbour";
+    addUserFiles(username);
+    addUserFiles(neighbour);
+
+    History(username, nullptr, &store).saveResult({"2024-01-01 10:00:00", "Win"});
+    History(neighbour, nullptr, &store).saveResult({"2024-01-01 11:00:00", "Loss"});
+
+    History::remove(username, &store);
+    EXPECT_EQ(0u, History(username, nullptr, &store).count());
+    EXPECT_EQ(0u, History(username, nullptr, &store).getStats().total.games);
+    EXPECT_EQ(1u, History(neighbour, nullptr, &store).count());
+
+    // The name can be used again from scratch
+    History(username, nullptr, &store).saveResult({"2024-01-02 10:00:00", "Draw"});
+    auto loaded = History(username, nullptr, &store).loadHistory();
+    ASSERT_EQ(1u, loaded.size());
+    EXPECT_EQ("Draw", loaded[0].result);
+}
+
+TEST_F(HistoryTest, QueriesDateRanges) {
+    std::string username = "query_test_user";
+    addUserFiles(username);
+
+    // One game a day at noon, January 1st to March 1st 2024
+    History history(username, nullptr, &store);
+    std::int64_t start = 0;
+    ASSERT_TRUE(History::parseDate("2024-01-01 12:00:00", start));
+    for (int day = 0; day < 61; ++day) {
+        history.saveResult({History::formatDate(start + day * 86400), day % 2 == 0 ? "Win" : "Loss"});
+    }
+
+    std::int64_t from = 0, to = 0;
+    ASSERT_TRUE(History::parseDate("2024-02-05", from));
+    ASSERT_TRUE(History::parseDate("2024-02-12", to));
+    auto week = history.query(from, to);
+    ASSERT_EQ(7u, week.size());
+    EXPECT_EQ("2024-02-05 12:00:00", week.front().date);
+    EXPECT_EQ("2024-02-11 12:00:00", week.back().date);
+
+    // The end is exclusive, ranges outside the history are empty
+    EXPECT_EQ(1u, history.query(start, start + 1).size());
+    EXPECT_EQ(0u, history.query(start - 86400, start).size());
+    EXPECT_EQ(61u, history.query(start, start + 61 * 86400).size());
+    EXPECT_TRUE(history.query(to, from).empty());
+
+    HistoryReader games = history.reader();
+    EXPECT_EQ(0u, games.lowerBound(start - 1));
+    EXPECT_EQ(31u, games.lowerBound(from - 4 * 86400));
+    EXPECT_EQ(games.size(), games.lowerBound(start + 61 * 86400));
+}
+
+TEST_F(HistoryTest, LateGamesAreSortedIn) {
+    std::string username = "late_games_user";
+    addUserFiles(username);
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-03-01 10:00:00", "Win"});
+    history.saveResult({"2024-03-03 10:00:00", "Win"});
+    history.saveResult({"2024-03-02 10:00:00", "Loss"});   // Saved late
+    history.saveResult({"2024-03-04 10:00:00", "Draw"});
+
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(4u, loaded.size());
+    EXPECT_EQ("2024-03-01 10:00:00", loaded[0].date);
+    EXPECT_EQ("2024-03-02 10:00:00", loaded[1].date);
+    EXPECT_EQ("2024-03-03 10:00:00", loaded[2].date);
+    EXPECT_EQ("Draw", loaded[3].result);
+    EXPECT_TRUE(history.verify());
+
+    std::int64_t from = 0, to = 0;
+    ASSERT_TRUE(History::parseDate("2024-03-02", from));
+    ASSERT_TRUE(History::parseDate("2024-03-03", to));
+    auto day = history.query(from, to);
+    ASSERT_EQ(1u, day.size());
+    EXPECT_EQ("Loss", day[0].result);
+
+    // Streaks follow the order games were played in
+    HistoryStats stats = history.getStats();
+    EXPECT_EQ(4u, stats.gamesCounted);
+    EXPECT_EQ(1u, stats.bestWinStreak);
+    EXPECT_EQ(0, stats.currentStreak);
+}
+
+TEST_F(HistoryTest, RecoversFromLostTail) {
+    std::string username = "recovery_test_user";
+    addUserFiles(username);
+
+    // The first game creates the user and is synced; the next ones are not
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-08-01 10:00:00", "Win"});
+    history.saveResult({"2024-08-02 10:00:00", "Win"});
+    history.saveResult({"2024-08-03 10:00:00", "Win"});
+
+    // A crash loses the second game's record (its CRC no longer matches)
+    std::int64_t timestamp = 0;
+    ASSERT_TRUE(History::parseDate("2024-08-02 10:00:00", timestamp));
+    std::string path = store.shardPath(username);
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::size_t at = bytes.rfind(std::string(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp)));
+    ASSERT_NE(std::string::npos, at);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(at + 8));
+        file.put(static_cast<char>(GameOutcome::LOSS));
+    }
+
+    // Reads stop at the last intact record
+    EXPECT_FALSE(history.verify());
+    EXPECT_EQ(1u, history.count());
+    EXPECT_EQ(1u, history.getStats().total.games);
+
+    // The next game is stored after it, and the history is whole again
+    history.saveResult({"2024-08-04 10:00:00", "Draw"});
+    auto loaded = history.loadHistory();
+    ASSERT_EQ(2u, loaded.size());
+    EXPECT_EQ("2024-08-01 10:00:00", loaded[0].date);
+    EXPECT_EQ("Draw", loaded[1].result);
+    EXPECT_EQ(2u, history.getStats().total.games);
+    EXPECT_TRUE(history.verify());
+}
+
+TEST_F(HistoryTest, ArchivesOldGames) {
+    std::string username = "archive_test_user";
+    addUserFiles(username);
+
+    // Enough games for several archived blocks; game i is i hours after the start
+    History history(username, nullptr, &store);
+    std::int64_t start = 0;
+    ASSERT_TRUE(History::parseDate("2023-01-01 00:00:00", start));
+    const int games = 1500;
+    std::vector<GameResult> saved;
+    for (int i = 0; i < games; ++i) {
+        GameResult result = {History::formatDate(start + i * 3600LL), i % 5 == 0 ? "Draw" : i % 3 == 0 ? "Loss" : "Win"};
+        result.mode = i % 2 == 0 ? HistoryMode::AI_HARD : HistoryMode::PLAYER;
+        result.opponent = i % 2 == 0 ? 0 : History::opponentId("Bob");
+        history.saveResult(result);
+        saved.push_back(result);
+    }
+
+    // Archived or not, every game reads back the same
+    auto loaded = History(username, nullptr, &store).loadHistory();
+    ASSERT_EQ(saved.size(), loaded.size());
+    for (std::size_t i = 0; i < saved.size(); ++i) {
+        ASSERT_EQ(saved[i].date, loaded[i].date) << "game " << i;
+        ASSERT_EQ(saved[i].result, loaded[i].result) << "game " << i;
+        ASSERT_EQ(saved[i].mode, loaded[i].mode) << "game " << i;
+        ASSERT_EQ(saved[i].opponent, loaded[i].opponent) << "game " << i;
+    }
+    EXPECT_TRUE(history.verify());
+
+    // Range queries and totals across archived blocks and recent games
+    auto range = history.query(start + 100 * 3600LL, start + 1400 * 3600LL);
+    ASSERT_EQ(1300u, range.size());
+    EXPECT_EQ(saved[100].date, range.front().date);
+    EXPECT_EQ(saved[1399].date, range.back().date);
+
+    HistoryReader reader = history.reader();
+    for (int i : {0, 255, 256, 700, 1499}) {
+        EXPECT_EQ(static_cast<std::size_t>(i), reader.lowerBound(start + i * 3600LL));
+    }
+
+    OutcomeTotals expected;
+    for (int i = 100; i < 1400; ++i) {
+        expected.add(i % 5 == 0 ? GameOutcome::DRAW : i % 3 == 0 ? GameOutcome::LOSS : GameOutcome::WIN);
+    }
+    OutcomeTotals totals = history.totals(start + 100 * 3600LL, start + 1400 * 3600LL);
+    EXPECT_EQ(expected.games, totals.games);
+    EXPECT_EQ(expected.wins, totals.wins);
+    EXPECT_EQ(expected.losses, totals.losses);
+    EXPECT_EQ(expected.draws, totals.draws);
+    EXPECT_EQ(static_cast<std::uint32_t>(games), history.totals(start, start + games * 3600LL).games);
+
+    // A late game from long ago is merged into the archived part
+    history.saveResult({History::formatDate(start + 10 * 3600LL + 1), "Win"});
+    HistoryReader merged = history.reader();
+    ASSERT_EQ(static_cast<std::size_t>(games + 1), merged.size());
+    EXPECT_EQ(start + 10 * 3600LL + 1, merged.record(11).timestamp);
+    EXPECT_EQ(static_cast<std::uint32_t>(games + 1), history.getStats().total.games);
+    EXPECT_TRUE(history.verify());
+}
+
+TEST_F(HistoryTest, ShardsStaySmall) {
+    // The fixture's store starts empty, so no other test's leftovers count
+    std::string username = "busy_player";
+    const int games = 20000;
+    for (int i = 0; i < games; ++i) {
+        HistoryRecord record;
+        record.timestamp = 1700000000LL + i * 600LL;
+        record.outcome = static_cast<std::uint8_t>(i % 4 == 0 ? GameOutcome::LOSS : GameOutcome::WIN);
+        record.mode = static_cast<std::uint8_t>(HistoryMode::AI_MEDIUM);
+        record.opponent = 0;
+        record.moveOffset = HistoryRecord::NO_MOVES;
+        ASSERT_TRUE(store.append(username, {record}));
+    }
+
+    // Archived games take a few bytes each and moved regions are reclaimed,
+    // so the shard stays below even the records' own size
+    EXPECT_LT(std::filesystem::file_size(store.shardPath(username)), games * sizeof(HistoryRecord));
+    EXPECT_EQ(static_cast<std::size_t>(games), store.open(username).size());
+    EXPECT_TRUE(store.verify(username));
+}
+
+TEST_F(HistoryTest, StoredGamesReachLeaderboard) {
+    std::string username = "leaderboard_test_user";
+    addUserFiles(username);
+    LeaderboardEntry entry;
+    EXPECT_FALSE(store.leaderboard().find(username, entry));
+
+    History history(username, nullptr, &store);
+    history.saveResult({"2024-09-01 10:00:00", "Win"});
+    history.saveResult({"2024-09-01 11:00:00", "Draw"});
+    ASSERT_TRUE(store.leaderboard().find(username, entry));
+    EXPECT_EQ(2u, entry.totals.games);
+    EXPECT_EQ(3u, entry.points());
+
+    // Deleted histories leave the board
+    History::remove(username, &store);
+    EXPECT_FALSE(store.leaderboard().find(username, entry));
+}
+
+TEST_F(HistoryTest, LeaderboardSeededFromStore) {
+    // Games stored before there was a board file
+    for (int user = 0; user < 20; ++user) {
+        std::string username = "seeded_user_" + std::to_string(user);
+        History history(username, nullptr, &store);
+        for (int game = 0; game <= user; ++game) {
+            history.saveResult({"2024-10-01 10:00:00", game % 2 == 0 ? "Win" : "Draw"});
+        }
+    }
+    std::filesystem::remove(directory + "/leaderboard.db");
+
+    // A store opening the same directory ranks everyone without a game played
+    HistoryStore reopened(directory);
+    Leaderboard& board = reopened.leaderboard();
+    EXPECT_EQ(20u, board.size());
+    auto top = board.top(1);
+    ASSERT_EQ(1u, top.size());
+    EXPECT_EQ("seeded_user_19", top[0].username);
+    EXPECT_EQ(20u, top[0].totals.games);
+    EXPECT_EQ(10u, top[0].totals.draws);
+
+    // The seeded board is on disk; an existing board is not seeded again
+    HistoryStore again(directory);
+    EXPECT_EQ(20u, again.leaderboard().size());
+    LeaderboardEntry entry;
+    ASSERT_TRUE(again.leaderboard().find("seeded_user_0", entry));
+    EXPECT_EQ(20u, entry.rank);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "HistoryArchive.h"
+#include <vector>
+
+namespace {
+    // A game every few minutes, mostly against the AI levels, a few opponents
+    std::vector<HistoryRecord> sampleGames(std::size_t count, std::int64_t start) {
+        std::vector<HistoryRecord> games;
+        std::int64_t time = start;
+        for (std::size_t i = 0; i < count; ++i) {
+            time += 60 + static_cast<std::int64_t>(i * 37 % 500);
+            HistoryRecord record;
+            record.timestamp = time;
+            record.outcome = static_cast<std::uint8_t>(i % 7 == 0 ? GameOutcome::DRAW
+                                                    : i % 3 == 0 ? GameOutcome::LOSS : GameOutcome::WIN);
+            record.mode = static_cast<std::uint8_t>(1 + i % 4);
+            record.opponent = record.mode == static_cast<std::uint8_t>(HistoryMode::PLAYER)
+                                  ? static_cast<std::uint16_t>(1000 + i % 5) : 0;
+            record.moveOffset = HistoryRecord::NO_MOVES;
+            games.push_back(record);
+        }
+        return games;
+    }
+
+    void expectSame(const HistoryRecord& expected, const HistoryRecord& actual) {
+        EXPECT_EQ(expected.timestamp, actual.timestamp);
+        EXPECT_EQ(expected.outcome, actual.outcome);
+        EXPECT_EQ(expected.mode, actual.mode);
+        EXPECT_EQ(expected.opponent, actual.opponent);
+        EXPECT_EQ(expected.moveOffset, actual.moveOffset);
+    }
+}
+
+TEST(HistoryArchiveTest, BlockRoundTrip) {
+    auto games = sampleGames(HistoryArchive::BLOCK_RECORDS, 1700000000);
+    std::vector<unsigned char> encoded;
+    HistoryArchive::encodeBlock(games.data(), games.size(), encoded);
+
+    HistoryArchive::BlockInfo info;
+    ASSERT_TRUE(HistoryArchive::readInfo(encoded.data(), encoded.size(), info));
+    EXPECT_EQ(games.size(), info.count);
+    EXPECT_EQ(encoded.size(), HistoryArchive::blockSize(info));
+    EXPECT_EQ(games.front().timestamp, info.minTime);
+    EXPECT_EQ(games.back().timestamp, info.maxTime);
+    EXPECT_EQ(games.size(), info.totals.games);
+
+    std::vector<HistoryRecord> decoded;
+    ASSERT_TRUE(HistoryArchive::decodeBlock(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(games.size(), decoded.size());
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        expectSame(games[i], decoded[i]);
+    }
+
+    // A fraction of the 16 bytes a record takes uncompressed
+    EXPECT_LT(encoded.size(), games.size() * sizeof(HistoryRecord) / 4);
+}
+
+TEST(HistoryArchiveTest, UnusualValuesRoundTrip) {
+    // Unsorted and negative timestamps, one distinct value per column, and
+    // values at the top of their range
+    std::vector<HistoryRecord> games(3);
+    games[0] = {5000000000LL, static_cast<std::uint8_t>(GameOutcome::UNKNOWN), 4, 0xFFFF, 0xFFFFFFFEu};
+    games[1] = {-86400, static_cast<std::uint8_t>(GameOutcome::UNKNOWN), 4, 0xFFFF, 0xFFFFFFFEu};
+    games[2] = {0, static_cast<std::uint8_t>(GameOutcome::UNKNOWN), 4, 0xFFFF, 0xFFFFFFFEu};
+
+    std::vector<unsigned char> encoded;
+    HistoryArchive::encodeBlock(games.data(), games.size(), encoded);
+    std::vector<HistoryRecord> decoded;
+    ASSERT_TRUE(HistoryArchive::decodeBlock(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(3u, decoded.size());
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        expectSame(games[i], decoded[i]);
+    }
+
+    // Empty blocks are valid too
+    encoded.clear();
+    HistoryArchive::encodeBlock(nullptr, 0, encoded);
+    ASSERT_TRUE(HistoryArchive::decodeBlock(encoded.data(), encoded.size(), decoded));
+    EXPECT_TRUE(decoded.empty());
+}
+
+TEST(HistoryArchiveTest, RejectsDamagedBlocks) {
+    auto games = sampleGames(100, 1700000000);
+    std::vector<unsigned char> encoded;
+    HistoryArchive::encodeBlock(games.data(), games.size(), encoded);
+    std::vector<HistoryRecord> decoded;
+
+    // Any flipped byte, in the header or a column
+    for (std::size_t at : {std::size_t(8), encoded.size() / 2, encoded.size() - 1}) {
+        std::vector<unsigned char> damaged = encoded;
+        damaged[at] ^= 0x10;
+        EXPECT_FALSE(HistoryArchive::decodeBlock(damaged.data(), damaged.size(), decoded)) << "byte " << at;
+    }
+
+    // Cut short
+    EXPECT_FALSE(HistoryArchive::decodeBlock(encoded.data(), encoded.size() - 1, decoded));
+    EXPECT_FALSE(HistoryArchive::decodeBlock(encoded.data(), 10, decoded));
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "HistoryCache.h"
+#include "HistoryStore.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    HistoryRecord game(std::int64_t timestamp, GameOutcome outcome) {
+        HistoryRecord record;
+        record.timestamp = timestamp;
+        record.outcome = static_cast<std::uint8_t>(outcome);
+        record.mode = static_cast<std::uint8_t>(HistoryMode::AI_EASY);
+        record.opponent = 0;
+        record.moveOffset = HistoryRecord::NO_MOVES;
+        return record;
+    }
+
+    HistorySnapshot snapshotOf(std::size_t games) {
+        HistorySnapshot snapshot;
+        for (std::size_t i = 0; i < games; ++i) {
+            snapshot.latest.push_back(game(static_cast<std::int64_t>(i), GameOutcome::WIN));
+            snapshot.stats.add(snapshot.latest.back());
+        }
+        snapshot.count = games;
+        return snapshot;
+    }
+}
+
+TEST(HistoryCacheTest, EvictsLeastRecentlyUsed) {
+    HistoryCache::Options options;
+    options.recentGames = 10;
+    HistoryCache probe(options);
+    probe.insert("someone", snapshotOf(10));
+    std::size_t perUser = probe.bytes();
+
+    // Room for three users
+    options.capacityBytes = perUser * 3 + perUser / 2;
+    HistoryCache cache(options);
+    cache.insert("ann", snapshotOf(10));
+    cache.insert("bob", snapshotOf(10));
+    cache.insert("cat", snapshotOf(10));
+
+    HistorySnapshot snapshot;
+    ASSERT_TRUE(cache.lookup("ann", snapshot));   // Now bob is the oldest use
+    cache.insert("dan", snapshotOf(10));
+
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_LE(cache.bytes(), options.capacityBytes);
+    EXPECT_FALSE(cache.lookup("bob", snapshot));
+    EXPECT_TRUE(cache.lookup("ann", snapshot));
+    EXPECT_TRUE(cache.lookup("cat", snapshot));
+    EXPECT_TRUE(cache.lookup("dan", snapshot));
+    EXPECT_EQ(4u, cache.hits());
+    EXPECT_EQ(1u, cache.misses());
+}
+
+TEST(HistoryCacheTest, KeepsLatestGamesOnAppend) {
+    HistoryCache::Options options;
+    options.recentGames = 4;
+    HistoryCache cache(options);
+
+    // Only the newest games of a long history are kept
+    cache.insert("ann", snapshotOf(6));
+    HistorySnapshot snapshot;
+    ASSERT_TRUE(cache.lookup("ann", snapshot));
+    EXPECT_EQ(6u, snapshot.count);
+    ASSERT_EQ(4u, snapshot.latest.size());
+    EXPECT_EQ(2, snapshot.latest.front().timestamp);
+
+    HistoryStats stats = snapshot.stats;
+    std::vector<HistoryRecord> added = {game(6, GameOutcome::LOSS), game(7, GameOutcome::DRAW)};
+    for (const HistoryRecord& record : added) {
+        stats.add(record);
+    }
+    cache.append("ann", stats, 8, added);
+    ASSERT_TRUE(cache.lookup("ann", snapshot));
+    EXPECT_EQ(8u, snapshot.count);
+    EXPECT_EQ(8u, snapshot.stats.total.games);
+    ASSERT_EQ(4u, snapshot.latest.size());
+    EXPECT_EQ(4, snapshot.latest.front().timestamp);
+    EXPECT_EQ(7, snapshot.latest.back().timestamp);
+
+    // Users not cached stay out
+    cache.append("bob", stats, 8, added);
+    EXPECT_FALSE(cache.lookup("bob", snapshot));
+}
+
+class HistoryCacheStoreTest : public ::testing::Test {
+protected:
+    const std::string directory = (std::filesystem::temp_directory_path() / "tictactoe_cache_test").string();
+    HistoryStore store{directory};
+
+    void SetUp() override {
+        std::filesystem::remove_all(directory); // Leftovers of an interrupted run
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+};
+
+TEST_F(HistoryCacheStoreTest, StoreWritesThrough) {
+    std::string username = "cached_player";
+
+    ASSERT_TRUE(store.append(username, {game(100, GameOutcome::WIN)}));
+    HistorySnapshot first = store.snapshot(username);
+    EXPECT_EQ(1u, first.count);
+    std::uint64_t misses = store.getCache().misses();
+
+    // Stored games show up without another read
+    ASSERT_TRUE(store.append(username, {game(200, GameOutcome::LOSS), game(300, GameOutcome::WIN)}));
+    HistorySnapshot second = store.snapshot(username);
+    EXPECT_EQ(misses, store.getCache().misses());
+    EXPECT_EQ(3u, second.count);
+    EXPECT_EQ(3u, second.stats.total.games);
+    ASSERT_EQ(3u, second.latest.size());
+    EXPECT_EQ(300, second.latest.back().timestamp);
+
+    // A late game is merged on disk and read again
+    ASSERT_TRUE(store.append(username, {game(150, GameOutcome::DRAW)}));
+    HistorySnapshot merged = store.snapshot(username);
+    EXPECT_EQ(4u, merged.count);
+    ASSERT_EQ(4u, merged.latest.size());
+    EXPECT_EQ(150, merged.latest[1].timestamp);
+    EXPECT_EQ(1u, merged.stats.total.draws);
+
+    // Removed users are forgotten
+    ASSERT_TRUE(store.remove(username));
+    EXPECT_EQ(0u, store.snapshot(username).count);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "HistoryWriter.h"
+#include "HistoryStore.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class HistoryWriterTest : public ::testing::Test {
+protected:
+    std::vector<std::string> users;
+    const std::string directory = (std::filesystem::temp_directory_path() / "tictactoe_writer_test").string();
+    HistoryStore store{directory};
+
+    void SetUp() override {
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override {
+        for (const auto& user : users) {
+            History::remove(user, &store);
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    std::string addUser(const std::string& user) {
+        users.push_back(user);
+        History::remove(user, &store); // Leftovers of an interrupted run
+        return user;
+    }
+
+    static std::string dateOf(int game) {
+        std::string second = std::to_string(game % 60);
+        std::string minute = std::to_string(game / 60 % 60);
+        return "2024-06-01 10:" + std::string(minute.size() < 2 ? "0" : "") + minute + ":" +
+               (second.size() < 2 ? "0" : "") + second;
+    }
+};
+
+TEST_F(HistoryWriterTest, FlushStoresQueuedResults) {
+    HistoryWriter writer;
+    History history(addUser("writer_flush_user"), &writer, &store);
+
+    const int games = 500;
+    for (int i = 0; i < games; ++i) {
+        history.saveResult({dateOf(i), i % 3 == 0 ? "Win" : i % 3 == 1 ? "Loss" : "Draw"});
+    }
+    EXPECT_TRUE(writer.flush());
+
+    // A History without the writer sees everything, in order
+    History direct("writer_flush_user", nullptr, &store);
+    auto loaded = direct.loadHistory();
+    ASSERT_EQ(static_cast<std::size_t>(games), loaded.size());
+    for (int i = 0; i < games; ++i) {
+        EXPECT_EQ(dateOf(i), loaded[i].date);
+    }
+    EXPECT_EQ(static_cast<std::uint32_t>(games), direct.getStats().total.games);
+    EXPECT_TRUE(direct.verify());
+
+    // Results are grouped: never more commits than results
+    EXPECT_GE(writer.batchesCommitted(), 1u);
+    EXPECT_LE(writer.batchesCommitted(), static_cast<std::uint64_t>(games));
+    EXPECT_EQ(0u, writer.failedResults());
+}
+
+TEST_F(HistoryWriterTest, ReadsSeeQueuedResults) {
+    HistoryWriter writer;
+    History history(addUser("writer_read_user"), &writer, &store);
+
+    history.saveResult({"2024-06-01 10:00:00", "Win"});
+    history.saveResult({"2024-06-01 10:05:00", "Loss"});
+
+    // Reading through the same History flushes first
+    EXPECT_EQ(2u, history.count());
+    EXPECT_EQ(1u, history.getStats().total.wins);
+}
+
+TEST_F(HistoryWriterTest, DestructionFlushes) {
+    std::string alice = addUser("writer_alice");
+    std::string bob = addUser("writer_bob");
+    {
+        HistoryWriter::Options options;
+        options.queueCapacity = 8;   // Small queue: saving has to wait for the worker
+        options.maxBatch = 4;
+        options.syncEachBatch = true;
+        HistoryWriter writer(options);
+
+        History aliceHistory(alice, &writer, &store);
+        History bobHistory(bob, &writer, &store);
+        for (int i = 0; i < 50; ++i) {
+            aliceHistory.saveResult({dateOf(i), "Win"});
+            bobHistory.saveResult({dateOf(i), "Loss"});
+        }
+    }
+
+    History aliceHistory(alice, nullptr, &store);
+    History bobHistory(bob, nullptr, &store);
+    EXPECT_EQ(50u, aliceHistory.count());
+    EXPECT_EQ(50u, bobHistory.count());
+    EXPECT_EQ(50u, aliceHistory.getStats().total.wins);
+    EXPECT_EQ(50u, bobHistory.getStats().total.losses);
+    EXPECT_EQ(50, aliceHistory.getStats().currentStreak);
+    EXPECT_TRUE(bobHistory.verify());
+}
+
+TEST_F(HistoryWriterTest, KeepsStoresApart) {
+    // The same name in two stores is two users
+    std::string user = addUser("writer_shared_name");
+    std::string otherDirectory = directory + "/other";
+    HistoryStore other(otherDirectory);
+    {
+        HistoryWriter writer;
+        History here(user, &writer, &store);
+        History there(user, &writer, &other);
+        for (int i = 0; i < 100; ++i) {
+            here.saveResult({dateOf(i), "Win"});
+            there.saveResult({dateOf(i), "Loss"});
+        }
+        EXPECT_TRUE(writer.flush());
+    }
+
+    EXPECT_EQ(100u, History(user, nullptr, &store).getStats().total.wins);
+    EXPECT_EQ(100u, History(user, nullptr, &other).getStats().total.losses);
+    EXPECT_EQ(100u, History(user, nullptr, &other).count());
+}
+
+TEST_F(HistoryWriterTest, ReportsUnwritableStore) {
+    // A store below a regular file can never be created, whoever runs the test
+    std::filesystem::create_directories(directory);
+    std::string blocker = directory + "/not_a_directory";
+    std::ofstream(blocker) << "x";
+    HistoryStore unwritable(blocker + "/history");
+
+    HistoryWriter::Options options;
+    options.maxAttempts = 2;
+    options.retryDelay = std::chrono::milliseconds(1);
+    HistoryWriter writer(options);
+    History history("writer_unwritable_user", &writer, &unwritable);
+    history.saveResult({dateOf(0), "Win"});
+    history.saveResult({dateOf(1), "Loss"});
+
+    EXPECT_FALSE(writer.flush());
+    EXPECT_EQ(2u, writer.failedResults());
+
+    // Later results to a working store are stored and reported as such
+    History working(addUser("writer_working_user"), &writer, &store);
+    working.saveResult({dateOf(2), "Draw"});
+    EXPECT_TRUE(writer.flush());
+    EXPECT_EQ(2u, writer.failedResults());
+    EXPECT_EQ(1u, History("writer_working_user", nullptr, &store).count());
+}
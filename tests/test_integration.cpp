@@ -3,6 +3,7 @@
 #include "Game.h"
 #include "AI.h"
 #include "History.h"
+#include "HistoryStore.h"
 #include <filesystem>
 #include <chrono>               // Used in performance test or creating timestamps
 #include <iostream>
@@ -11,6 +12,11 @@
 class IntegrationTest : public ::testing::Test {
 protected:
     std::vector<std::string> testFiles; // Track test files for cleanup
+    std::vector<std::string> users;     // Track users whose history is deleted
+
+    // Histories go to a directory of their own, deleted with the test files
+    const std::string directory = (std::filesystem::temp_directory_path() / "tictactoe_integration_test").string();
+    HistoryStore store{directory};
 
     void SetUp() override {
         // Setup for each test
@@ -26,21 +32,27 @@ protected:
         testFiles.push_back(filename);
     }
 
+    // The user's games are deleted with the test files
+    void addUserFiles(const std::string& username) {
+        users.push_back(username);
+    }
+
     void cleanupTestFiles() {
         // Clean up specific test files and any that might have been created
         std::vector<std::string> filesToRemove = {
             "integration_test_users.db",
             "test_integration_users.db",
             "game_session_users.db",
-            "tournament_users.db",
-            "history_alice.txt",
-            "history_bob.txt",
-            "history_testplayer1.txt",
-            "history_testplayer2.txt",
-            "history_player1.txt",
-            "history_player2.txt",
-            "history_integration_user.txt"
+            "tournament_users.db"
         };
+        for (const std::string user : {"alice", "bob", "testplayer1", "testplayer2",
+                                       "player1", "player2", "integration_user"}) {
+            History::remove(user, &store);
+        }
+        for (const auto& user : users) {
+            History::remove(user, &store);
+        }
+        users.clear();
         
         // Add tracked files
         filesToRemove.insert(filesToRemove.end(), testFiles.begin(), testFiles.end());
@@ -51,6 +63,7 @@ protected:
             }
         }
         testFiles.clear();
+        std::filesystem::remove_all(directory);
     }
 
     std::string getCurrentTimestamp() {
@@ -83,7 +96,7 @@ TEST_F(IntegrationTest, CompleteUserSession) {
     std::string password = "testpass123";
     
     addTestFile(dbFile);
-    addTestFile("history_" + username + ".txt");
+    addUserFiles(username);
     
     // 1. User Registration
     Auth auth(dbFile);
@@ -96,7 +109,7 @@ TEST_F(IntegrationTest, CompleteUserSession) {
     // 3. Initialize game components
     Game game;
     AI ai(Player::O);
-    History history(username);
+    History history(username, nullptr, &store);
     
     // 4. Play a complete game (Human vs AI)
     std::cout << "=== Playing Human vs AI Game ===" << std::endl;
@@ -157,8 +170,8 @@ TEST_F(IntegrationTest, MultiPlayerGameSession) {
     // Test multiple players registering and playing games
     std::string dbFile = "game_session_users.db";
     addTestFile(dbFile);
-    addTestFile("history_alice.txt");
-    addTestFile("history_bob.txt");
+    addUserFiles("alice");
+    addUserFiles("bob");
     
     Auth auth(dbFile);
     auth.clearAllUsers();
@@ -172,8 +185,8 @@ TEST_F(IntegrationTest, MultiPlayerGameSession) {
     ASSERT_TRUE(auth.loginUser("bob", "password2"));
     
     // Create history objects for both players
-    History aliceHistory("alice");
-    History bobHistory("bob");
+    History aliceHistory("alice", nullptr, &store);
+    History bobHistory("bob", nullptr, &store);
     
     // Play multiple games between Alice (X) and Bob (O)
     for (int gameNum = 1; gameNum <= 3; gameNum++) {
@@ -273,8 +286,8 @@ TEST_F(IntegrationTest, AITournament) {
     // Test AI vs AI games with different scenarios
     std::string dbFile = "tournament_users.db";
     addTestFile(dbFile);
-    addTestFile("history_testplayer1.txt");
-    addTestFile("history_testplayer2.txt");
+    addUserFiles("testplayer1");
+    addUserFiles("testplayer2");
     
     Auth auth(dbFile);
     auth.clearAllUsers();
@@ -282,8 +295,8 @@ TEST_F(IntegrationTest, AITournament) {
     ASSERT_TRUE(auth.registerUser("testplayer1", "pass1"));
     ASSERT_TRUE(auth.registerUser("testplayer2", "pass2"));
     
-    History player1History("testplayer1");
-    History player2History("testplayer2");
+    History player1History("testplayer1", nullptr, &store);
+    History player2History("testplayer2", nullptr, &store);
     
     AI aiX(Player::X);
     AI aiO(Player::O);
@@ -426,8 +439,8 @@ TEST_F(IntegrationTest, HistoryIntegrityWithMultipleUsers) {
     
     // Setup histories for multiple users
     for (const auto& user : users) {
-        addTestFile("history_" + user + ".txt");
-        histories.emplace_back(user);
+        addUserFiles(user);
+        histories.emplace_back(user, nullptr, &store);
     }
     
     // Each user plays different numbers of games with different results
@@ -491,7 +504,7 @@ TEST_F(IntegrationTest, StressTestAllComponents) {
         std::string username = "stressuser" + std::to_string(i);
         std::string password = "pass" + std::to_string(i);
         
-        addTestFile("history_" + username + ".txt");
+        addUserFiles(username);
         
         ASSERT_TRUE(auth.registerUser(username, password));
         ASSERT_TRUE(auth.loginUser(username, password));
@@ -502,7 +515,7 @@ TEST_F(IntegrationTest, StressTestAllComponents) {
     
     for (int userId = 1; userId <= numUsers; userId++) {
         std::string username = "stressuser" + std::to_string(userId);
-        History userHistory(username);
+        History userHistory(username, nullptr, &store);
         
         for (int gameNum = 1; gameNum <= gamesPerUser; gameNum++) {
             Game game;
@@ -548,7 +561,7 @@ TEST_F(IntegrationTest, StressTestAllComponents) {
         
         EXPECT_TRUE(auth.userExists(username));
         
-        History userHistory(username);
+        History userHistory(username, nullptr, &store);
         auto history = userHistory.loadHistory();
         
         EXPECT_EQ(gamesPerUser, history.size()) 
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "Leaderboard.h"
+#include "History.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    OutcomeTotals totalsOf(std::uint32_t wins, std::uint32_t losses, std::uint32_t draws) {
+        OutcomeTotals totals;
+        totals.wins = wins;
+        totals.losses = losses;
+        totals.draws = draws;
+        totals.games = wins + losses + draws;
+        return totals;
+    }
+
+    class LeaderboardTest : public ::testing::Test {
+    protected:
+        const std::string path = "leaderboard_test.db";
+
+        void SetUp() override {
+            std::remove(path.c_str());
+        }
+
+        void TearDown() override {
+            std::remove(path.c_str());
+            std::remove((path + ".tmp").c_str());
+        }
+    };
+}
+
+TEST_F(LeaderboardTest, RanksByPoints) {
+    Leaderboard board(path);
+    board.update("ann", totalsOf(3, 0, 0));   // 6 points
+    board.update("bob", totalsOf(2, 1, 2));   // 6 points, fewer wins
+    board.update("cat", totalsOf(4, 5, 1));   // 9 points
+    board.update("dan", totalsOf(0, 3, 0));   // 0 points
+    board.update("eve", totalsOf(0, 0, 0));   // No games: not ranked
+
+    auto top = board.top(10);
+    ASSERT_EQ(4u, top.size());
+    EXPECT_EQ("cat", top[0].username);
+    EXPECT_EQ("ann", top[1].username);
+    EXPECT_EQ("bob", top[2].username);
+    EXPECT_EQ("dan", top[3].username);
+    EXPECT_EQ(9u, top[0].points());
+    EXPECT_EQ(4u, top[3].rank);
+    EXPECT_EQ(2u, board.top(2).size());
+
+    // A new game moves a user up
+    board.update("dan", totalsOf(5, 3, 0));
+    LeaderboardEntry entry;
+    ASSERT_TRUE(board.find("dan", entry));
+    EXPECT_EQ(1u, entry.rank);
+    ASSERT_TRUE(board.find("cat", entry));
+    EXPECT_EQ(2u, entry.rank);
+    EXPECT_FALSE(board.find("eve", entry));
+
+    EXPECT_TRUE(board.remove("dan"));
+    EXPECT_FALSE(board.remove("dan"));
+    EXPECT_EQ(3u, board.size());
+    EXPECT_EQ("cat", board.top(1)[0].username);
+}
+
+TEST_F(LeaderboardTest, MatchesFullSortUnderRandomUpdates) {
+    Leaderboard board(path);
+    std::mt19937 random(7);
+    std::vector<OutcomeTotals> expected(300);
+    for (int step = 0; step < 5000; ++step) {
+        std::size_t user = random() % expected.size();
+        OutcomeTotals& totals = expected[user];
+        switch (random() % 3) {
+        case 0: totals.wins++; break;
+        case 1: totals.losses++; break;
+        default: totals.draws++; break;
+        }
+        totals.games++;
+        board.update("user" + std::to_string(user), totals);
+    }
+
+    // The same order as sorting everybody from scratch
+    std::vector<LeaderboardEntry> sorted;
+    for (std::size_t user = 0; user < expected.size(); ++user) {
+        if (expected[user].games == 0) continue;
+        LeaderboardEntry entry;
+        entry.username = "user" + std::to_string(user);
+        entry.totals = expected[user];
+        sorted.push_back(entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
+        if (a.points() != b.points()) return a.points() > b.points();
+        if (a.totals.wins != b.totals.wins) return a.totals.wins > b.totals.wins;
+        if (a.totals.games != b.totals.games) return a.totals.games < b.totals.games;
+        return a.username < b.username;
+    });
+
+    auto top = board.top(sorted.size());
+    ASSERT_EQ(sorted.size(), top.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        ASSERT_EQ(sorted[i].username, top[i].username) << "rank " << i + 1;
+        LeaderboardEntry entry;
+        ASSERT_TRUE(board.find(sorted[i].username, entry));
+        ASSERT_EQ(i + 1, entry.rank);
+    }
+}
+
+TEST_F(LeaderboardTest, ReloadsFromLog) {
+    {
+        Leaderboard board(path);
+        board.update("ann", totalsOf(1, 0, 0));
+        board.update("bob", totalsOf(2, 0, 0));
+        board.update("ann", totalsOf(3, 1, 0));
+        board.update("cat", totalsOf(1, 1, 1));
+        board.remove("cat");
+    }
+    {
+        Leaderboard board(path);
+        auto top = board.top(10);
+        ASSERT_EQ(2u, top.size());
+        EXPECT_EQ("ann", top[0].username);
+        EXPECT_EQ(4u, top[0].totals.games);
+        EXPECT_EQ("bob", top[1].username);
+
+        board.update("dan", totalsOf(9, 0, 0));
+    }
+
+    // A torn last record is dropped, the rest is kept
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("\x07\x00\x00", 3);
+    }
+    {
+        Leaderboard board(path);
+        EXPECT_EQ(3u, board.size());
+        EXPECT_EQ("dan", board.top(1)[0].username);
+        board.update("eve", totalsOf(0, 1, 0));
+    }
+
+    // Updates after it are readable again
+    Leaderboard board(path);
+    EXPECT_EQ(4u, board.size());
+    LeaderboardEntry entry;
+    ASSERT_TRUE(board.find("eve", entry));
+    EXPECT_EQ(4u, entry.rank);
+}
+
+TEST_F(LeaderboardTest, CompactsLog) {
+    {
+        Leaderboard board(path);
+        for (std::uint32_t game = 1; game <= 10000; ++game) {
+            board.update(game % 2 == 0 ? "ann" : "bob", totalsOf(game, 0, 0));
+        }
+    }
+
+    // Superseded records are rewritten away, the board is unchanged
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    EXPECT_LT(static_cast<std::size_t>(in.tellg()), std::size_t(5000) * 27);
+    Leaderboard board(path);
+    auto top = board.top(2);
+    ASSERT_EQ(2u, top.size());
+    EXPECT_EQ("ann", top[0].username);
+    EXPECT_EQ(10000u, top[0].totals.wins);
+    EXPECT_EQ(9999u, top[1].totals.wins);
+}
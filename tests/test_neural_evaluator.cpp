@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "NeuralEvaluator.h"     // Class under test
+#include "AI.h"                  // Search integration
+#include "BoardKey.h"            // Position keys
+#include <filesystem>           // For deleting test files
+#include <random>
+
+class NeuralEvaluatorTest : public ::testing::Test {
+protected:
+    const std::string weightsFile = "test_evaluator.bin";
+
+    void TearDown() override {
+        if (std::filesystem::exists(weightsFile)) {
+            std::filesystem::remove(weightsFile);
+        }
+    }
+
+    // Random network with values small enough to keep every sum in range
+    NeuralEvaluator::Weights randomWeights(unsigned int seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> small(-40, 40);
+        std::uniform_int_distribution<int> large(-3000, 3000);
+        NeuralEvaluator::Weights weights;
+        for (auto& w : weights.inputWeights) w = static_cast<std::int16_t>(small(rng));
+        for (auto& w : weights.hiddenBias) w = static_cast<std::int16_t>(small(rng) + 40);
+        for (auto& w : weights.outputWeights) w = static_cast<std::int16_t>(large(rng));
+        weights.outputBias = large(rng);
+        return weights;
+    }
+
+    bool sameAccumulator(const NeuralEvaluator::Accumulator& a, const NeuralEvaluator::Accumulator& b) {
+        for (int p = 0; p < 2; ++p) {
+            for (int unit = 0; unit < NeuralEvaluator::HIDDEN; ++unit) {
+                if (a.values[p][unit] != b.values[p][unit]) return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(NeuralEvaluatorTest, ZeroNetworkIsNeutral) {
+    NeuralEvaluator net;
+    EXPECT_EQ(0, net.evaluate(0x011, 0x100));
+}
+
+TEST_F(NeuralEvaluatorTest, IncrementalMatchesRefresh) {
+    NeuralEvaluator net(randomWeights(1));
+    std::mt19937 rng(2);
+
+    for (int game = 0; game < 50; ++game) {
+        Game board;
+        NeuralEvaluator::Accumulator incremental;
+        net.refresh(incremental, 0, 0);
+        std::vector<std::pair<Player, int>> made;
+
+        while (board.getWinner() == Player::NONE && !board.isDraw()) {
+            auto moves = board.getAvailableMoves();
+            auto move = moves[rng() % moves.size()];
+            Player mover = board.getCurrentPlayer();
+            board.makeMove(move.first, move.second);
+            net.addMark(incremental, mover, move.first * 3 + move.second);
+            made.emplace_back(mover, move.first * 3 + move.second);
+
+            std::uint32_t key = BoardKey::fromGame(board);
+            NeuralEvaluator::Accumulator full;
+            net.refresh(full, key & 0x1FF, key >> 9);
+            ASSERT_TRUE(sameAccumulator(full, incremental));
+        }
+
+        // Unmaking every mark returns to the empty board
+        for (auto it = made.rbegin(); it != made.rend(); ++it) {
+            net.removeMark(incremental, it->first, it->second);
+        }
+        NeuralEvaluator::Accumulator empty;
+        net.refresh(empty, 0, 0);
+        EXPECT_TRUE(sameAccumulator(empty, incremental));
+    }
+}
+
+TEST_F(NeuralEvaluatorTest, MatchesScalarReference) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // The AVX2 kernels are always built and picked whenever the CPU has AVX2
+    EXPECT_EQ(__builtin_cpu_supports("avx2") != 0, NeuralEvaluator::usesSimd());
+#endif
+
+    NeuralEvaluator net(randomWeights(3));
+    const NeuralEvaluator::Weights& weights = net.getWeights();
+    for (std::uint16_t x = 0; x < 512; ++x) {
+        for (std::uint16_t o = 0; o < 512; o += 7) {
+            if (x & o) continue;
+            NeuralEvaluator::Accumulator accumulator;
+            net.refresh(accumulator, x, o);
+
+            // First layer summed one weight at a time: X's point of view, then O's
+            for (int unit = 0; unit < NeuralEvaluator::HIDDEN; ++unit) {
+                int sums[2] = {weights.hiddenBias[unit], weights.hiddenBias[unit]};
+                for (int cell = 0; cell < 9; ++cell) {
+                    if (x & (1u << cell)) {
+                        sums[0] += weights.inputWeights[cell * NeuralEvaluator::HIDDEN + unit];
+                        sums[1] += weights.inputWeights[(cell + 9) * NeuralEvaluator::HIDDEN + unit];
+                    }
+                    if (o & (1u << cell)) {
+                        sums[0] += weights.inputWeights[(cell + 9) * NeuralEvaluator::HIDDEN + unit];
+                        sums[1] += weights.inputWeights[cell * NeuralEvaluator::HIDDEN + unit];
+                    }
+                }
+                ASSERT_EQ(sums[0], accumulator.values[0][unit]);
+                ASSERT_EQ(sums[1], accumulator.values[1][unit]);
+            }
+
+            for (Player toMove : {Player::X, Player::O}) {
+                ASSERT_EQ(net.evaluateScalar(accumulator, toMove), net.evaluate(accumulator, toMove));
+            }
+        }
+    }
+}
+
+TEST_F(NeuralEvaluatorTest, SaveAndLoad) {
+    NeuralEvaluator net(randomWeights(4));
+    ASSERT_TRUE(net.save(weightsFile));
+
+    NeuralEvaluator loaded;
+    ASSERT_TRUE(loaded.load(weightsFile));
+    EXPECT_EQ(net.getWeights().inputWeights, loaded.getWeights().inputWeights);
+    EXPECT_EQ(net.getWeights().outputBias, loaded.getWeights().outputBias);
+    EXPECT_EQ(net.evaluate(0x011, 0x100), loaded.evaluate(0x011, 0x100));
+
+    // Truncated file is rejected and leaves the network unchanged
+    std::filesystem::resize_file(weightsFile, std::filesystem::file_size(weightsFile) - 2);
+    NeuralEvaluator untouched;
+    EXPECT_FALSE(untouched.load(weightsFile));
+    EXPECT_EQ(0, untouched.evaluate(0x011, 0x100));
+    EXPECT_FALSE(untouched.load("missing_evaluator.bin"));
+}
+
+TEST_F(NeuralEvaluatorTest, DrivesShallowSearch) {
+    // One hidden unit that fires when the opponent of the side to move holds
+    // (2,2): after one ply that is the AI's own mark, so the AI wants it
+    NeuralEvaluator::Weights weights;
+    weights.inputWeights[(9 + 8) * NeuralEvaluator::HIDDEN] = NeuralEvaluator::ACTIVATION_MAX;
+    weights.outputWeights[0] = -64 * 50;
+    NeuralEvaluator net(weights);
+
+    SearchLimits limits;
+    limits.maxDepth = 1;
+    AI ai(Player::X, limits);
+    ai.setNeuralEvaluator(&net);
+    Game game;
+    EXPECT_EQ(std::make_pair(2, 2), ai.findBestMove(game));
+
+    // Without the network the line evaluator prefers the center again
+    ai.setNeuralEvaluator(nullptr);
+    EXPECT_EQ(std::make_pair(1, 1), ai.findBestMove(game));
+}
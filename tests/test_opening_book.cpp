@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "OpeningBook.h"         // Class under test
+#include "AI.h"                  // Book moves are compared against the search
+#include "BoardKey.h"            // Symmetry helpers
+#include <filesystem>           // For deleting test files
+#include <fstream>              // For writing a corrupt book
+
+class OpeningBookTest : public ::testing::Test {
+protected:
+    const std::string bookFile = "test_opening_book.bin";
+
+    void TearDown() override {
+        if (std::filesystem::exists(bookFile)) {
+            std::filesystem::remove(bookFile);
+        }
+    }
+
+    // Builds and opens a book of the given depth
+    void buildBook(OpeningBook& book, int plies) {
+        ASSERT_TRUE(OpeningBook::write(bookFile, OpeningBook::build(plies)));
+        ASSERT_TRUE(book.open(bookFile));
+    }
+};
+
+TEST_F(OpeningBookTest, SymmetryRoundTrip) {
+    // Every symmetry followed by its inverse gives back the original cell
+    for (int s = 0; s < BoardKey::SYMMETRY_COUNT; ++s) {
+        for (int cell = 0; cell < 9; ++cell) {
+            int image = BoardKey::transformCell(cell, s);
+            EXPECT_EQ(cell, BoardKey::transformCell(image, BoardKey::inverseSymmetry(s)));
+        }
+    }
+    
+    // All four corner openings share one canonical key
+    int symmetry = 0;
+    std::uint32_t reference = BoardKey::canonical(1u << 0, symmetry);
+    for (int corner : {2, 6, 8}) {
+        EXPECT_EQ(reference, BoardKey::canonical(1u << corner, symmetry));
+    }
+}
+
+TEST_F(OpeningBookTest, KeyTransformMatchesCells) {
+    // Whole-key transform agrees with moving every occupied cell on its own
+    for (std::uint32_t key = 0; key < (1u << 18); key += 37) {
+        if ((key & 0x1FF) & (key >> 9)) continue; // Both players on one cell
+        for (int s = 0; s < BoardKey::SYMMETRY_COUNT; ++s) {
+            std::uint32_t expected = 0;
+            for (int cell = 0; cell < 9; ++cell) {
+                int image = BoardKey::transformCell(cell, s);
+                if (key & (1u << cell)) expected |= 1u << image;
+                if (key & (1u << (cell + 9))) expected |= 1u << (image + 9);
+            }
+            ASSERT_EQ(expected, BoardKey::transform(key, s));
+        }
+    }
+}
+
+TEST_F(OpeningBookTest, BuildDeduplicatesSymmetricPositions) {
+    // Empty board, then 3 distinct first moves (corner, edge, center)
+    EXPECT_EQ(1u, OpeningBook::build(0).size());
+    EXPECT_EQ(4u, OpeningBook::build(1).size());
+}
+
+TEST_F(OpeningBookTest, ProbeReturnsOptimalMoves) {
+    OpeningBook book;
+    buildBook(book, 2);
+    EXPECT_EQ(OpeningBook::build(2).size(), book.size());
+    
+    // Each corner opening must be answered with the center, in every orientation
+    for (auto corner : {std::make_pair(0, 0), std::make_pair(0, 2),
+                        std::make_pair(2, 0), std::make_pair(2, 2)}) {
+        Game game;
+        game.makeMove(corner.first, corner.second);
+        
+        std::pair<int, int> move;
+        ASSERT_TRUE(book.probe(game, move));
+        EXPECT_EQ(std::make_pair(1, 1), move);
+    }
+    
+    // Positions deeper than the book are not found
+    Game deep;
+    deep.makeMove(0, 0);
+    deep.makeMove(1, 1);
+    deep.makeMove(2, 2);
+    std::pair<int, int> move;
+    EXPECT_FALSE(book.probe(deep, move));
+}
+
+TEST_F(OpeningBookTest, AIUsesBookInsteadOfSearching) {
+    OpeningBook book;
+    buildBook(book, 2);
+    
+    Game game;
+    game.makeMove(1, 1); // X takes center
+    
+    AI ai(Player::O);
+    ai.setOpeningBook(&book);
+    auto move = ai.findBestMove(game);
+    const SearchStats& stats = ai.getLastSearchStats();
+    
+    EXPECT_TRUE(stats.fromBook);
+    EXPECT_EQ(0u, stats.counters.nodes);
+    EXPECT_EQ(Player::NONE, game.at(move.first, move.second));
+    
+    // The book move is as good as the searched one: a corner
+    EXPECT_TRUE(move.first != 1 && move.second != 1);
+}
+
+TEST_F(OpeningBookTest, RejectsInvalidFiles) {
+    OpeningBook book;
+    EXPECT_FALSE(book.open("missing_opening_book.bin"));
+    
+    std::ofstream out(bookFile, std::ios::binary);
+    out << "not a book";
+    out.close();
+    EXPECT_FALSE(book.open(bookFile));
+    EXPECT_FALSE(book.isOpen());
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "ProofSolver.h"         // Class under test
+#include "AI.h"                  // Cross-check against the alpha-beta search
+#include <random>                // Random positions for the cross-check
+
+class ProofSolverTest : public ::testing::Test {
+protected:
+    // Converts the best analysed move into the value of the position
+    ProofResult valueFromSearch(const Game& game) {
+        AI ai(game.getCurrentPlayer());
+        auto analysis = ai.analyze(game);
+        switch (analysis[0].outcome) {
+        case MoveOutcome::WIN: return ProofResult::WIN;
+        case MoveOutcome::LOSS: return ProofResult::LOSS;
+        default: return ProofResult::DRAW;
+        }
+    }
+};
+
+TEST_F(ProofSolverTest, EmptyBoardIsDraw) {
+    ProofSolver solver;
+    EXPECT_EQ(ProofResult::DRAW, solver.solve(Game()));
+    EXPECT_GT(solver.nodes(), 0u);
+}
+
+TEST_F(ProofSolverTest, ProvesWinAndLoss) {
+    Game game;
+    game.makeMove(1, 1); // X
+    game.makeMove(0, 1); // O - edge reply to the center loses
+    
+    ProofSolver solver;
+    EXPECT_EQ(ProofResult::WIN, solver.solve(game));   // X to move wins
+    
+    Game attacked;
+    attacked.makeMove(1, 1);
+    attacked.makeMove(0, 1);
+    attacked.makeMove(0, 0); // X keeps the win going
+    EXPECT_EQ(ProofResult::LOSS, solver.solve(attacked)); // O to move loses
+}
+
+TEST_F(ProofSolverTest, FinishedGames) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(1, 0); // O
+    game.makeMove(0, 1); // X
+    game.makeMove(1, 1); // O
+    game.makeMove(0, 2); // X wins
+    
+    ProofSolver solver;
+    EXPECT_EQ(ProofResult::LOSS, solver.solve(game)); // O to move has already lost
+}
+
+TEST_F(ProofSolverTest, TinyTableStillSolves) {
+    // Memory is bounded by the table; a tiny table only costs re-search
+    ProofSolver small(16);
+    EXPECT_EQ(16u, small.tableSize());
+    EXPECT_EQ(ProofResult::DRAW, small.solve(Game()));
+}
+
+TEST_F(ProofSolverTest, NodeCapGivesUnknown) {
+    ProofSolver capped(1 << 10, 5);
+    EXPECT_EQ(ProofResult::UNKNOWN, capped.solve(Game()));
+}
+
+TEST_F(ProofSolverTest, AgreesWithSearchOnRandomPositions) {
+    std::mt19937 rng(2024);
+    ProofSolver solver;
+    
+    for (int trial = 0; trial < 40; ++trial) {
+        Game game;
+        int plies = static_cast<int>(rng() % 6);
+        for (int i = 0; i < plies && game.getWinner() == Player::NONE; ++i) {
+            auto moves = game.getAvailableMoves();
+            auto move = moves[rng() % moves.size()];
+            game.makeMove(move.first, move.second);
+        }
+        if (game.getWinner() != Player::NONE) {
+            continue;
+        }
+        EXPECT_EQ(valueFromSearch(game), solver.solve(game)) << "Trial " << trial;
+    }
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "SampleFile.h"          // Classes under test
+#include <filesystem>           // For deleting test files
+#include <fstream>              // For truncating a sample file
+
+class SampleFileTest : public ::testing::Test {
+protected:
+    const std::string sampleFile = "test_samples.bin";
+
+    void TearDown() override {
+        if (std::filesystem::exists(sampleFile)) {
+            std::filesystem::remove(sampleFile);
+        }
+    }
+
+    // A game of 'length' samples whose keys encode (game, ply)
+    std::vector<TrainingSample> makeGame(std::uint32_t game, int length) {
+        std::vector<TrainingSample> samples;
+        for (int ply = 0; ply < length; ++ply) {
+            samples.push_back({game * 16 + static_cast<std::uint32_t>(ply),
+                               static_cast<std::int16_t>(ply - 4),
+                               static_cast<std::uint8_t>(ply),
+                               static_cast<std::int8_t>(game % 3 - 1)});
+        }
+        return samples;
+    }
+};
+
+TEST_F(SampleFileTest, RoundTripInChunks) {
+    SampleWriter writer(20);
+    ASSERT_TRUE(writer.open(sampleFile));
+    for (std::uint32_t game = 0; game < 10; ++game) {
+        ASSERT_TRUE(writer.addGame(makeGame(game, 5 + game % 5)));
+    }
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(10u, writer.gameCount());
+
+    SampleReader reader;
+    ASSERT_TRUE(reader.open(sampleFile));
+    EXPECT_EQ(writer.sampleCount(), reader.sampleCount());
+    EXPECT_EQ(10u, reader.gameCount());
+    EXPECT_GT(reader.chunkCount(), 1u);
+
+    // Samples come back in order, no chunk exceeds its capacity
+    std::uint32_t game = 0;
+    int ply = 0;
+    for (std::size_t c = 0; c < reader.chunkCount(); ++c) {
+        std::size_t count = 0;
+        const TrainingSample* samples = reader.chunk(c, count);
+        ASSERT_NE(nullptr, samples);
+        EXPECT_LE(count, 20u);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (ply == 5 + static_cast<int>(game % 5)) {
+                game++;
+                ply = 0;
+            }
+            EXPECT_EQ(game * 16 + static_cast<std::uint32_t>(ply), samples[i].key);
+            EXPECT_EQ(ply - 4, samples[i].value);
+            EXPECT_EQ(ply, samples[i].move);
+            EXPECT_EQ(static_cast<int>(game % 3) - 1, samples[i].outcome);
+            ply++;
+        }
+    }
+    EXPECT_EQ(9u, game);
+}
+
+TEST_F(SampleFileTest, GamesAreNotSplit) {
+    // 4 games of 9 samples with room for 10: one game per chunk
+    SampleWriter writer(10);
+    ASSERT_TRUE(writer.open(sampleFile));
+    for (std::uint32_t game = 0; game < 4; ++game) {
+        ASSERT_TRUE(writer.addGame(makeGame(game, 9)));
+    }
+    ASSERT_TRUE(writer.close());
+
+    SampleReader reader;
+    ASSERT_TRUE(reader.open(sampleFile));
+    ASSERT_EQ(4u, reader.chunkCount());
+    std::size_t count = 0;
+    reader.chunk(3, count);
+    EXPECT_EQ(9u, count);
+    EXPECT_EQ(nullptr, reader.chunk(4, count));
+}
+
+TEST_F(SampleFileTest, RejectsUnfinishedFile) {
+    SampleWriter writer;
+    ASSERT_TRUE(writer.open(sampleFile));
+    ASSERT_TRUE(writer.addGame(makeGame(0, 7)));
+    ASSERT_TRUE(writer.close());
+
+    // Cut off the footer, as after a crash mid-run
+    auto size = std::filesystem::file_size(sampleFile);
+    std::filesystem::resize_file(sampleFile, size - 4);
+
+    SampleReader reader;
+    EXPECT_FALSE(reader.open(sampleFile));
+    EXPECT_FALSE(reader.open("missing_samples.bin"));
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "Tablebase.h"           // Class under test
+#include "AI.h"                  // Tablebase moves are compared against the search
+#include "BoardKey.h"            // Position keys
+#include <filesystem>           // For deleting test files
+#include <random>
+
+class TablebaseTest : public ::testing::Test {
+protected:
+    static const std::string tablebaseFile;
+    static Tablebase tablebase;
+
+    // Generated once; every test only reads it
+    static void SetUpTestSuite() {
+        ASSERT_TRUE(Tablebase::generate(tablebaseFile, 2));
+        ASSERT_TRUE(tablebase.open(tablebaseFile));
+    }
+
+    static void TearDownTestSuite() {
+        tablebase.close();
+        std::filesystem::remove(tablebaseFile);
+    }
+};
+
+const std::string TablebaseTest::tablebaseFile = "test_tablebase.bin";
+Tablebase TablebaseTest::tablebase;
+
+TEST_F(TablebaseTest, StoresEveryCanonicalPosition) {
+    // 765 legal positions up to symmetry, in well under one page
+    EXPECT_EQ(765u, tablebase.size());
+    EXPECT_LE(std::filesystem::file_size(tablebaseFile), 4096u);
+}
+
+TEST_F(TablebaseTest, KnownValues) {
+    ProofResult result;
+    int distance = 0;
+
+    Game empty;
+    ASSERT_TRUE(tablebase.probe(empty, result, distance));
+    EXPECT_EQ(ProofResult::DRAW, result);
+    EXPECT_EQ(9, distance);
+
+    // X: (0,0),(1,1)  O: (0,1),(2,2) -> X forks and wins in 3 plies
+    Game fork;
+    fork.makeMove(0, 0);
+    fork.makeMove(0, 1);
+    fork.makeMove(1, 1);
+    fork.makeMove(2, 2);
+    ASSERT_TRUE(tablebase.probe(fork, result, distance));
+    EXPECT_EQ(ProofResult::WIN, result);
+    EXPECT_EQ(3, distance);
+
+    // Finished game: the side to move has lost
+    Game won;
+    won.makeMove(0, 0); won.makeMove(1, 0);
+    won.makeMove(0, 1); won.makeMove(1, 1);
+    won.makeMove(0, 2);
+    ASSERT_TRUE(tablebase.probe(won, result, distance));
+    EXPECT_EQ(ProofResult::LOSS, result);
+    EXPECT_EQ(0, distance);
+    std::pair<int, int> move;
+    EXPECT_FALSE(tablebase.bestMove(won, move));
+}
+
+TEST_F(TablebaseTest, AgreesWithSearchOnRandomPositions) {
+    std::mt19937 rng(11);
+    AI search(Player::X);
+    for (int game = 0; game < 200; ++game) {
+        Game board;
+        int plies = static_cast<int>(rng() % 8);
+        for (int i = 0; i < plies && board.getWinner() == Player::NONE && !board.isDraw(); ++i) {
+            auto moves = board.getAvailableMoves();
+            auto move = moves[rng() % moves.size()];
+            board.makeMove(move.first, move.second);
+        }
+        if (board.getWinner() != Player::NONE || board.isDraw()) continue;
+
+        // Tablebase move scores as well as the best move of a full search
+        std::pair<int, int> move;
+        ASSERT_TRUE(tablebase.bestMove(board, move));
+        auto analysis = search.analyze(board);
+        for (const auto& entry : analysis) {
+            if (entry.move == move) {
+                EXPECT_EQ(analysis.front().score, entry.score) << "game " << game;
+            }
+        }
+
+        ProofResult result;
+        int distance = 0;
+        ASSERT_TRUE(tablebase.probe(board, result, distance));
+        MoveOutcome expected = (result == ProofResult::WIN) ? MoveOutcome::WIN
+                             : (result == ProofResult::LOSS) ? MoveOutcome::LOSS
+                             : MoveOutcome::DRAW;
+        EXPECT_EQ(expected, analysis.front().outcome) << "game " << game;
+        EXPECT_EQ(distance, analysis.front().distance) << "game " << game;
+    }
+}
+
+TEST_F(TablebaseTest, AIAnswersWithoutSearching) {
+    AI ai(Player::O);
+    ai.setTablebase(&tablebase);
+    Game game;
+    game.makeMove(0, 0);
+
+    auto move = ai.findBestMove(game);
+    EXPECT_EQ(std::make_pair(1, 1), move); // Only the center holds the draw
+    EXPECT_TRUE(ai.getLastSearchStats().fromTablebase);
+    EXPECT_EQ(0u, ai.getLastSearchStats().counters.nodes);
+}
+
+TEST_F(TablebaseTest, RejectsInvalidFiles) {
+    Tablebase other;
+    EXPECT_FALSE(other.open("missing_tablebase.bin"));
+
+    std::filesystem::copy_file(tablebaseFile, "test_tablebase_cut.bin",
+                               std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file("test_tablebase_cut.bin", std::filesystem::file_size(tablebaseFile) - 1);
+    EXPECT_FALSE(other.open("test_tablebase_cut.bin"));
+    std::filesystem::remove("test_tablebase_cut.bin");
+}
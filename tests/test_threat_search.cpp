@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "ThreatSearch.h"        // Class under test
+#include "AI.h"                  // Pre-pass integration and cross-checks
+
+class ThreatSearchTest : public ::testing::Test {
+protected:
+    // Plays out a forcing line and returns the final position
+    Game playLine(Game game, const std::vector<std::pair<int, int>>& line) {
+        for (const auto& move : line) {
+            EXPECT_TRUE(game.makeMove(move.first, move.second));
+        }
+        return game;
+    }
+};
+
+TEST_F(ThreatSearchTest, WinningCells) {
+    // X on (0,0) and (0,1): (0,2) completes the top row
+    EXPECT_EQ(1u << 2, ThreatSearch::winningCells(0x003, 0x000));
+    // Blocked line is not a threat
+    EXPECT_EQ(0u, ThreatSearch::winningCells(0x003, 0x004));
+}
+
+TEST_F(ThreatSearchTest, FindsForkWin) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(0, 1); // O
+    game.makeMove(1, 1); // X
+    game.makeMove(2, 2); // O
+    // Board: X O .
+    //        . X .
+    //        . . O
+    // X forks with (1,0) or (2,0) and wins two moves later
+    
+    ThreatSearch tss;
+    std::vector<std::pair<int, int>> line;
+    ASSERT_TRUE(tss.findForcedWin(game, line));
+    ASSERT_EQ(3u, line.size());
+    
+    Game end = playLine(game, line);
+    EXPECT_EQ(Player::X, end.getWinner());
+    EXPECT_GT(tss.nodes(), 0u);
+}
+
+TEST_F(ThreatSearchTest, NoForcedWinFromEmptyBoard) {
+    Game game;
+    ThreatSearch tss;
+    std::vector<std::pair<int, int>> line;
+    EXPECT_FALSE(tss.findForcedWin(game, line));
+    EXPECT_TRUE(line.empty());
+}
+
+TEST_F(ThreatSearchTest, RespectsOpponentThreat) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(1, 0); // O
+    game.makeMove(1, 1); // X
+    game.makeMove(1, 2); // O
+    game.makeMove(2, 1); // X
+    // Board: X . .
+    //        O X O
+    //        . X .
+    // O to move must block (2,2) first; no forced win for O exists
+    
+    ThreatSearch tss;
+    std::vector<std::pair<int, int>> line;
+    EXPECT_FALSE(tss.findForcedWin(game, line));
+}
+
+TEST_F(ThreatSearchTest, AgreesWithFullSearch) {
+    // Whenever threat-space search claims a win, the exact search agrees
+    Game game;
+    game.makeMove(1, 1); // X
+    game.makeMove(0, 1); // O (edge reply loses)
+    
+    ThreatSearch tss;
+    std::vector<std::pair<int, int>> line;
+    ASSERT_TRUE(tss.findForcedWin(game, line));
+    EXPECT_EQ(Player::X, playLine(game, line).getWinner());
+    
+    AI ai(Player::X);
+    auto analysis = ai.analyze(game);
+    for (const auto& entry : analysis) {
+        if (entry.move == line[0]) {
+            EXPECT_EQ(MoveOutcome::WIN, entry.outcome);
+        }
+    }
+}
+
+TEST_F(ThreatSearchTest, AIUsesPrePass) {
+    Game game;
+    game.makeMove(0, 0); // X
+    game.makeMove(0, 1); // O
+    game.makeMove(1, 1); // X
+    game.makeMove(2, 2); // O
+    
+    AI ai(Player::X);
+    auto move = ai.findBestMove(game);
+    const SearchStats& stats = ai.getLastSearchStats();
+    
+    EXPECT_TRUE(stats.fromThreatSearch);
+    EXPECT_EQ(0u, stats.counters.nodes); // No alpha-beta search was needed
+    EXPECT_GT(stats.counters.threatNodes, 0u);
+    EXPECT_EQ(move, stats.principalVariation[0]);
+}
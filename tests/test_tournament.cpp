@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>         // Google Test framework
+#include "Tournament.h"          // Classes under test
+#include <cmath>
+#include <map>
+
+TEST(TournamentTest, EloModel) {
+    EXPECT_DOUBLE_EQ(0.5, Sprt::expectedScore(0.0));
+    EXPECT_NEAR(100.0, Sprt::eloFromScore(Sprt::expectedScore(100.0)), 1e-9);
+    EXPECT_LT(Sprt::eloFromScore(0.25), 0.0);
+}
+
+TEST(TournamentTest, SprtDecides) {
+    Sprt sprt(0.0, 10.0, 0.05, 0.05);
+    EXPECT_NEAR(std::log(0.05 / 0.95), sprt.lowerBound(), 1e-12);
+    EXPECT_NEAR(std::log(0.95 / 0.05), sprt.upperBound(), 1e-12);
+
+    // Too little evidence either way
+    EXPECT_EQ(SprtDecision::CONTINUE, sprt.decide(3, 4, 2));
+    // Clear superiority
+    EXPECT_EQ(SprtDecision::ACCEPT_H1, sprt.decide(300, 400, 150));
+    // Clear inferiority, and equal engines that always draw
+    EXPECT_EQ(SprtDecision::ACCEPT_H0, sprt.decide(100, 400, 200));
+    EXPECT_EQ(SprtDecision::ACCEPT_H0, sprt.decide(0, 500, 0));
+    EXPECT_GT(sprt.llr(60, 10, 30), sprt.llr(30, 10, 60));
+}
+
+TEST(TournamentTest, StrongerEngineAccepted) {
+    TournamentSettings settings;
+    settings.engineA = {"hard", SearchLimits::forDifficulty(Difficulty::HARD)};
+    settings.engineB = {"easy", SearchLimits::forDifficulty(Difficulty::EASY)};
+    settings.maxGames = 4000;
+    settings.threads = 2;
+
+    std::uint64_t reported = 0;
+    std::map<std::uint64_t, int> gamesPerOpening;
+    std::map<std::uint64_t, std::string> openingOf;
+    Tournament tournament(settings);
+    TournamentResult result = tournament.run([&](const TournamentGame& game) {
+        EXPECT_EQ(reported++, game.index);
+        gamesPerOpening[game.opening]++;
+
+        // Both games of a pair start with the same random move
+        auto known = openingOf.emplace(game.opening, game.moves.substr(0, 1));
+        EXPECT_EQ(known.first->second, game.moves.substr(0, 1));
+    });
+
+    EXPECT_EQ(SprtDecision::ACCEPT_H1, result.decision);
+    EXPECT_EQ(reported, result.games());
+    EXPECT_LT(result.games(), settings.maxGames);
+    EXPECT_GT(result.elo(), 0.0);
+    EXPECT_GE(result.llr, settings.sprt.upperBound());
+    for (const auto& opening : gamesPerOpening) {
+        EXPECT_LE(opening.second, 2);
+    }
+}
+
+TEST(TournamentTest, PerfectEnginesOnlyDraw) {
+    // Perfect play from the empty board is a draw whichever engine plays
+    // which colour; the SPRT rejects any strength difference
+    TournamentSettings settings;
+    settings.engineA = {"hard", SearchLimits::forDifficulty(Difficulty::HARD)};
+    settings.engineB = {"hard", SearchLimits::forDifficulty(Difficulty::HARD)};
+    settings.randomPlies = 0;
+    settings.maxGames = 1000;
+    settings.threads = 2;
+
+    TournamentResult result = Tournament(settings).run();
+    EXPECT_EQ(0u, result.wins);
+    EXPECT_EQ(0u, result.losses);
+    EXPECT_EQ(SprtDecision::ACCEPT_H0, result.decision);
+    EXPECT_DOUBLE_EQ(0.0, result.eloMargin());
+}
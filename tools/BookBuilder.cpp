@@ -0,0 +1,33 @@
+// BookBuilder.cpp
+// Offline tool: solves the early positions of the game and writes the
+// opening book that AI::findBestMove probes before searching.
+//
+// Usage: BookBuilder [output file] [plies]
+#include "OpeningBook.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string output = (argc > 1) ? argv[1] : "opening_book.bin";
+    int plies = (argc > 2) ? std::atoi(argv[2]) : 4;
+    if (plies < 0 || plies > 8) {
+        std::cerr << "Plies must be between 0 and 8" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BookEntry> entries = OpeningBook::build(plies);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    if (!OpeningBook::write(output, entries)) {
+        std::cerr << "Error: Could not write opening book: " << output << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << entries.size() << " positions (" << plies << " plies) to "
+              << output << " in " << elapsed.count() << "ms" << std::endl;
+    return 0;
+}
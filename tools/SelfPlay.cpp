@@ -0,0 +1,195 @@
+// SelfPlay.cpp
+// Offline tool: plays AI-vs-AI games in parallel and streams every engine
+// move as a labelled training sample (position, move, search value, final
+// outcome) to a chunked sample file, see SampleFile.h.
+//
+// Usage: SelfPlay [output file] [games] [options]
+//   --x <easy|medium|hard>   engine playing X (default: medium)
+//   --o <easy|medium|hard>   engine playing O (default: medium)
+//   --noise <n>              root noise of both engines (default: level's own)
+//   --random-plies <n>       random opening moves before the engines take over (default: 2)
+//   --threads <n>            worker threads (default: one per hardware thread)
+//   --chunk <n>              samples per chunk (default: 4096)
+//   --seed <n>               base random seed (default: 1)
+// With more than one thread, games are written in completion order.
+#include "AI.h"
+#include "BoardKey.h"
+#include "SampleFile.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string output = "selfplay.bin";
+        long games = 1000;
+        Difficulty engines[2] = {Difficulty::MEDIUM, Difficulty::MEDIUM};  // X, O
+        int noise = -1;             // -1 = keep the level's own noise
+        int randomPlies = 2;
+        unsigned int threads = 0;
+        std::size_t chunk = 4096;
+        unsigned int seed = 1;
+    };
+
+    // Accepts the level names shown in the game, in any case
+    bool parseDifficulty(std::string text, Difficulty& difficulty) {
+        for (char& ch : text) {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        for (Difficulty d : {Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD}) {
+            std::string name = AI::difficultyName(d);
+            name[0] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[0])));
+            if (text == name) {
+                difficulty = d;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        int positional = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) {
+                if (positional == 0) options.output = arg;
+                else if (positional == 1) options.games = std::atol(arg.c_str());
+                else return false;
+                positional++;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            std::string value = argv[++i];
+            if (arg == "--x") {
+                if (!parseDifficulty(value, options.engines[0])) return false;
+            } else if (arg == "--o") {
+                if (!parseDifficulty(value, options.engines[1])) return false;
+            } else if (arg == "--noise") {
+                options.noise = std::atoi(value.c_str());
+            } else if (arg == "--random-plies") {
+                options.randomPlies = std::atoi(value.c_str());
+            } else if (arg == "--threads") {
+                options.threads = static_cast<unsigned int>(std::atoi(value.c_str()));
+            } else if (arg == "--chunk") {
+                options.chunk = static_cast<std::size_t>(std::atol(value.c_str()));
+            } else if (arg == "--seed") {
+                options.seed = static_cast<unsigned int>(std::atol(value.c_str()));
+            } else {
+                return false;
+            }
+        }
+        return options.games > 0 && options.randomPlies >= 0 && options.randomPlies <= 8;
+    }
+
+    // Plays one game and returns the engine moves as samples
+    std::vector<TrainingSample> playGame(AI* engines[2], std::mt19937& rng, int randomPlies) {
+        Game game;
+        std::vector<TrainingSample> samples;
+        std::vector<Player> movers;
+
+        for (int ply = 0; game.getWinner() == Player::NONE && !game.isDraw(); ++ply) {
+            std::vector<std::pair<int, int>> moves = game.getAvailableMoves();
+            if (ply < randomPlies) {
+                // Random openings spread the data; these moves are not labelled
+                auto move = moves[std::uniform_int_distribution<std::size_t>(0, moves.size() - 1)(rng)];
+                game.makeMove(move.first, move.second);
+                continue;
+            }
+
+            AI& engine = *engines[game.getCurrentPlayer() == Player::X ? 0 : 1];
+            std::pair<int, int> move = engine.findBestMove(game);
+
+            // Value of the played move from the search that chose it; only
+            // unscored shortcuts (forced replies, book moves) are analyzed
+            const SearchStats& stats = engine.getLastSearchStats();
+            int value = stats.score;
+            if (!stats.scored) {
+                for (const auto& analysis : engine.analyze(game)) {
+                    if (analysis.move == move) {
+                        value = analysis.score;
+                    }
+                }
+            }
+
+            samples.push_back({BoardKey::fromGame(game), static_cast<std::int16_t>(value),
+                               static_cast<std::uint8_t>(move.first * 3 + move.second), 0});
+            movers.push_back(game.getCurrentPlayer());
+            game.makeMove(move.first, move.second);
+        }
+
+        Player winner = game.getWinner();
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            samples[i].outcome = (winner == Player::NONE) ? 0 : (winner == movers[i]) ? 1 : -1;
+        }
+        return samples;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: SelfPlay [output file] [games] [--x level] [--o level] [--noise n]"
+                     " [--random-plies n] [--threads n] [--chunk n] [--seed n]" << std::endl;
+        return 1;
+    }
+
+    SampleWriter writer(options.chunk);
+    if (!writer.open(options.output)) {
+        std::cerr << "Error: Could not open output file: " << options.output << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(options.threads);
+    std::atomic<long> nextGame{0};
+    std::atomic<bool> failed{false};
+    std::mutex writerMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t w = 0; w < pool.threadCount(); ++w) {
+        pool.submit([&, w] {
+            SearchLimits limits[2];
+            for (int side = 0; side < 2; ++side) {
+                limits[side] = SearchLimits::forDifficulty(options.engines[side]);
+                if (options.noise >= 0) {
+                    limits[side].rootNoise = options.noise;
+                }
+            }
+            AI xEngine(Player::X, limits[0]);
+            AI oEngine(Player::O, limits[1]);
+            AI* engines[2] = {&xEngine, &oEngine};
+
+            std::mt19937 rng(options.seed + static_cast<unsigned int>(w));
+            xEngine.setRandomSeed(rng());
+            oEngine.setRandomSeed(rng());
+
+            while (!failed && nextGame++ < options.games) {
+                std::vector<TrainingSample> samples = playGame(engines, rng, options.randomPlies);
+                std::lock_guard<std::mutex> lock(writerMutex);
+                if (!writer.addGame(samples)) {
+                    failed = true;
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    if (!writer.close() || failed) {
+        std::cerr << "Error: Could not write samples to: " << options.output << std::endl;
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Wrote " << writer.sampleCount() << " samples from " << writer.gameCount()
+              << " games to " << options.output << " in " << elapsed.count() << "ms" << std::endl;
+    return 0;
+}
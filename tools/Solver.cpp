@@ -0,0 +1,73 @@
+// Solver.cpp
+// Command-line front end of ProofSolver: proves the exact value of positions.
+//
+// Usage: Solver [board ...]
+//   board: 9 characters, row by row, 'X', 'O' or '.' (default: empty board)
+//   e.g.   Solver X...O....
+#include "BoardKey.h"
+#include "ProofSolver.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Parses a board string; false if it is malformed or unreachable
+static bool parseBoard(const std::string& text, Game& game) {
+    if (text.size() != 9) {
+        return false;
+    }
+
+    std::uint32_t key = 0;
+    int xCount = 0;
+    int oCount = 0;
+    for (int cell = 0; cell < 9; ++cell) {
+        char ch = text[cell];
+        if (ch == 'X' || ch == 'x') {
+            key |= 1u << cell;
+            xCount++;
+        } else if (ch == 'O' || ch == 'o') {
+            key |= 1u << (cell + 9);
+            oCount++;
+        } else if (ch != '.' && ch != '-') {
+            return false;
+        }
+    }
+
+    // X moves first, so X has as many marks as O or one more
+    if (xCount != oCount && xCount != oCount + 1) {
+        return false;
+    }
+    game = BoardKey::toGame(key);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> boards;
+    for (int i = 1; i < argc; ++i) {
+        boards.push_back(argv[i]);
+    }
+    if (boards.empty()) {
+        boards.push_back(".........");
+    }
+
+    ProofSolver solver;
+    int status = 0;
+    for (const auto& text : boards) {
+        Game game;
+        if (!parseBoard(text, game)) {
+            std::cerr << "Invalid board: " << text << std::endl;
+            status = 1;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ProofResult result = solver.solve(game);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        std::cout << text << " " << (game.getCurrentPlayer() == Player::X ? "X" : "O")
+                  << " to move: " << ProofSolver::resultName(result)
+                  << " (" << solver.nodes() << " nodes, " << elapsed.count() << "us)" << std::endl;
+    }
+    return status;
+}
@@ -0,0 +1,36 @@
+// TablebaseBuilder.cpp
+// Offline tool: solves every legal position by retrograde analysis and
+// writes the tablebase that AI::findBestMove answers from without searching.
+//
+// Usage: TablebaseBuilder [output file] [threads]
+#include "Tablebase.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string output = (argc > 1) ? argv[1] : "tablebase.bin";
+    int threads = (argc > 2) ? std::atoi(argv[2]) : 0;
+    if (threads < 0) {
+        std::cerr << "Threads must not be negative" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!Tablebase::generate(output, static_cast<unsigned int>(threads))) {
+        std::cerr << "Error: Could not write tablebase: " << output << std::endl;
+        return 1;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    Tablebase tablebase;
+    if (!tablebase.open(output)) {
+        std::cerr << "Error: Written tablebase does not load: " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << tablebase.size() << " positions to " << output
+              << " in " << elapsed.count() << "ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+// TournamentRunner.cpp
+// Offline tool: plays engine A against engine B on all cores and stops as
+// soon as an SPRT on their Elo difference decides. Games come in pairs with
+// the same random opening and colours swapped.
+//
+// Usage: TournamentRunner --a <engine> --b <engine> [options]
+//   engine: easy | medium | hard, optionally followed by overrides,
+//           e.g. "hard:depth=4,nodes=2000,time=50,noise=1"
+//   --games <n>          maximum number of games (default: 2000)
+//   --random-plies <n>   random opening moves (default: 1)
+//   --threads <n>        worker threads (default: one per hardware thread)
+//   --seed <n>           base random seed (default: 1)
+//   --elo0 <x> --elo1 <x> --alpha <x> --beta <x>   SPRT parameters (default: 0 10 0.05 0.05)
+//   --csv <file>         one line per game
+//   --json <file>        match summary
+// Exit status: 0 if H1 was accepted (A is stronger), 2 if H0 or undecided, 1 on errors.
+#include "Tournament.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    // Parses "level[:key=value,...]"
+    bool parseEngine(const std::string& spec, EngineConfig& engine) {
+        std::string level = spec.substr(0, spec.find(':'));
+        for (char& ch : level) {
+            ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+        }
+        if (level == "easy") engine.limits = SearchLimits::forDifficulty(Difficulty::EASY);
+        else if (level == "medium") engine.limits = SearchLimits::forDifficulty(Difficulty::MEDIUM);
+        else if (level == "hard") engine.limits = SearchLimits::forDifficulty(Difficulty::HARD);
+        else return false;
+        engine.name = spec;
+
+        if (spec.find(':') == std::string::npos) {
+            return true;
+        }
+        std::stringstream overrides(spec.substr(spec.find(':') + 1));
+        std::string item;
+        while (std::getline(overrides, item, ',')) {
+            std::size_t equals = item.find('=');
+            if (equals == std::string::npos) {
+                return false;
+            }
+            std::string key = item.substr(0, equals);
+            long value = std::atol(item.c_str() + equals + 1);
+            if (key == "depth") engine.limits.maxDepth = static_cast<int>(value);
+            else if (key == "nodes") engine.limits.maxNodes = static_cast<std::uint64_t>(value);
+            else if (key == "time") engine.limits.maxTime = std::chrono::milliseconds(value);
+            else if (key == "noise") engine.limits.rootNoise = static_cast<int>(value);
+            else return false;
+        }
+        return true;
+    }
+
+    std::string jsonString(const std::string& text) {
+        std::string quoted = "\"";
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') quoted += '\\';
+            quoted += ch;
+        }
+        return quoted + "\"";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    TournamentSettings settings;
+    settings.maxGames = 2000;
+    std::string csvPath;
+    std::string jsonPath;
+    double elo0 = 0.0, elo1 = 10.0, alpha = 0.05, beta = 0.05;
+    bool haveA = false, haveB = false;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+        bool ok = true;
+        if (option == "--a") ok = haveA = parseEngine(value, settings.engineA);
+        else if (option == "--b") ok = haveB = parseEngine(value, settings.engineB);
+        else if (option == "--games") settings.maxGames = std::strtoull(value.c_str(), nullptr, 10);
+        else if (option == "--random-plies") settings.randomPlies = std::atoi(value.c_str());
+        else if (option == "--threads") settings.threads = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if (option == "--seed") settings.seed = static_cast<unsigned int>(std::atol(value.c_str()));
+        else if (option == "--elo0") elo0 = std::atof(value.c_str());
+        else if (option == "--elo1") elo1 = std::atof(value.c_str());
+        else if (option == "--alpha") alpha = std::atof(value.c_str());
+        else if (option == "--beta") beta = std::atof(value.c_str());
+        else if (option == "--csv") csvPath = value;
+        else if (option == "--json") jsonPath = value;
+        else ok = false;
+        if (!ok) {
+            std::cerr << "Invalid option: " << option << " " << value << std::endl;
+            return 1;
+        }
+    }
+    if (!haveA || !haveB || argc % 2 == 0 || settings.randomPlies < 0 ||
+        alpha <= 0.0 || alpha >= 1.0 || beta <= 0.0 || beta >= 1.0) {
+        std::cerr << "Usage: TournamentRunner --a <engine> --b <engine> [--games n] [--random-plies n]"
+                     " [--threads n] [--seed n] [--elo0 x] [--elo1 x] [--alpha x] [--beta x]"
+                     " [--csv file] [--json file]" << std::endl;
+        return 1;
+    }
+    settings.sprt = Sprt(elo0, elo1, alpha, beta);
+
+    std::ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath, std::ios::trunc);
+        if (!csv.is_open()) {
+            std::cerr << "Error: Could not open CSV file: " << csvPath << std::endl;
+            return 1;
+        }
+        csv << "game,pair,x,o,result,moves\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Tournament tournament(settings);
+    TournamentResult result = tournament.run([&](const TournamentGame& game) {
+        if (csv.is_open()) {
+            const std::string& x = game.aPlaysX ? settings.engineA.name : settings.engineB.name;
+            const std::string& o = game.aPlaysX ? settings.engineB.name : settings.engineA.name;
+            Player winnerSide = (game.result == 0) ? Player::NONE
+                              : ((game.result > 0) == game.aPlaysX) ? Player::X : Player::O;
+            csv << game.index << "," << game.opening << "," << x << "," << o << ","
+                << (winnerSide == Player::X ? "1-0" : winnerSide == Player::O ? "0-1" : "1/2-1/2") << ","
+                << game.moves << "\n";
+        }
+    });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    std::cout << settings.engineA.name << " vs " << settings.engineB.name << ": "
+              << "+" << result.wins << " =" << result.draws << " -" << result.losses
+              << " (" << result.games() << " games, " << elapsed.count() << "ms)" << std::endl;
+    std::cout << "Elo " << result.elo() << " +/- " << result.eloMargin()
+              << ", LLR " << result.llr << " [" << settings.sprt.lowerBound() << ", "
+              << settings.sprt.upperBound() << "]: " << Tournament::decisionName(result.decision) << std::endl;
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath, std::ios::trunc);
+        json << "{\n"
+             << "  \"engineA\": " << jsonString(settings.engineA.name) << ",\n"
+             << "  \"engineB\": " << jsonString(settings.engineB.name) << ",\n"
+             << "  \"games\": " << result.games() << ",\n"
+             << "  \"wins\": " << result.wins << ",\n"
+             << "  \"draws\": " << result.draws << ",\n"
+             << "  \"losses\": " << result.losses << ",\n"
+             << "  \"score\": " << result.score() << ",\n"
+             << "  \"elo\": " << result.elo() << ",\n"
+             << "  \"eloMargin\": " << result.eloMargin() << ",\n"
+             << "  \"sprt\": {\"elo0\": " << elo0 << ", \"elo1\": " << elo1
+             << ", \"alpha\": " << alpha << ", \"beta\": " << beta
+             << ", \"llr\": " << result.llr << ", \"lower\": " << settings.sprt.lowerBound()
+             << ", \"upper\": " << settings.sprt.upperBound()
+             << ", \"decision\": " << jsonString(Tournament::decisionName(result.decision)) << "},\n"
+             << "  \"elapsedMs\": " << elapsed.count() << "\n"
+             << "}\n";
+        if (!json.good()) {
+            std::cerr << "Error: Could not write JSON file: " << jsonPath << std::endl;
+            return 1;
+        }
+    }
+
+    return (result.decision == SprtDecision::ACCEPT_H1) ? 0 : 2;
+}
@@ -0,0 +1,147 @@
+// TrainEvaluator.cpp
+// Offline tool: fits the neural evaluator to self-play samples (see SelfPlay)
+// and writes quantized weights that NeuralEvaluator::load reads.
+//
+// Usage: TrainEvaluator <sample file> [weights file] [epochs]
+// Training runs in floating point on the search values of the samples,
+// augmented with all 8 board symmetries. Samples are streamed chunk by
+// chunk from the mapped file, so memory does not grow with the data set.
+#include "BoardKey.h"
+#include "NeuralEvaluator.h"
+#include "SampleFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+    const int INPUTS = NeuralEvaluator::INPUTS;
+    const int HIDDEN = NeuralEvaluator::HIDDEN;
+
+    // Targets are search values clamped to +/- TARGET_RANGE, trained in units of SCALE
+    const float TARGET_RANGE = 200.0f;
+    const float SCALE = 100.0f;
+
+    // Float twin of the quantized network: hidden = clamp(x, 0, 1), output in units of SCALE
+    struct FloatNet {
+        float inputWeights[INPUTS][HIDDEN];
+        float hiddenBias[HIDDEN];
+        float outputWeights[HIDDEN];
+        float outputBias = 0.0f;
+    };
+
+    std::int16_t quantize(float value, float factor) {
+        float scaled = std::round(value * factor);
+        return static_cast<std::int16_t>(std::max(-32767.0f, std::min(scaled, 32767.0f)));
+    }
+
+    // One SGD step on one position; returns the squared error before the step
+    float train(FloatNet& net, const int* features, int featureCount, float target, float rate) {
+        float sums[HIDDEN];
+        float output = net.outputBias;
+        for (int unit = 0; unit < HIDDEN; ++unit) {
+            sums[unit] = net.hiddenBias[unit];
+            for (int i = 0; i < featureCount; ++i) {
+                sums[unit] += net.inputWeights[features[i]][unit];
+            }
+            output += net.outputWeights[unit] * std::max(0.0f, std::min(sums[unit], 1.0f));
+        }
+
+        float error = output - target;
+        net.outputBias -= rate * error;
+        for (int unit = 0; unit < HIDDEN; ++unit) {
+            float activation = std::max(0.0f, std::min(sums[unit], 1.0f));
+            float hiddenGradient = (sums[unit] > 0.0f && sums[unit] < 1.0f) ? error * net.outputWeights[unit] : 0.0f;
+            net.outputWeights[unit] -= rate * error * activation;
+            net.hiddenBias[unit] -= rate * hiddenGradient;
+            for (int i = 0; i < featureCount; ++i) {
+                net.inputWeights[features[i]][unit] -= rate * hiddenGradient;
+            }
+        }
+        return error * error;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: TrainEvaluator <sample file> [weights file] [epochs]" << std::endl;
+        return 1;
+    }
+    std::string output = (argc > 2) ? argv[2] : "evaluator.bin";
+    int epochs = (argc > 3) ? std::atoi(argv[3]) : 10;
+
+    SampleReader reader;
+    if (!reader.open(argv[1])) {
+        std::cerr << "Error: Could not read sample file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    FloatNet net;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> init(-0.1f, 0.1f);
+    for (auto& row : net.inputWeights) {
+        for (float& weight : row) weight = init(rng);
+    }
+    for (int unit = 0; unit < HIDDEN; ++unit) {
+        net.hiddenBias[unit] = 0.5f + init(rng);
+        net.outputWeights[unit] = init(rng);
+    }
+
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        float rate = 0.01f / (1.0f + epoch);
+        double totalError = 0.0;
+        std::uint64_t positions = 0;
+
+        for (std::size_t c = 0; c < reader.chunkCount(); ++c) {
+            std::size_t count = 0;
+            const TrainingSample* samples = reader.chunk(c, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                std::uint32_t key = samples[i].key;
+                bool xToMove = BoardKey::countCells(key & 0x1FF) == BoardKey::countCells(key >> 9);
+                float target = std::max(-TARGET_RANGE, std::min(static_cast<float>(samples[i].value), TARGET_RANGE)) / SCALE;
+
+                for (int s = 0; s < BoardKey::SYMMETRY_COUNT; ++s) {
+                    std::uint32_t image = BoardKey::transform(key, s);
+                    std::uint32_t mine = xToMove ? (image & 0x1FF) : (image >> 9);
+                    std::uint32_t theirs = xToMove ? (image >> 9) : (image & 0x1FF);
+
+                    int features[9];
+                    int featureCount = 0;
+                    for (int cell = 0; cell < 9; ++cell) {
+                        if (mine & (1u << cell)) features[featureCount++] = cell;
+                        if (theirs & (1u << cell)) features[featureCount++] = cell + 9;
+                    }
+                    totalError += train(net, features, featureCount, target, rate);
+                    positions++;
+                }
+            }
+        }
+
+        std::cout << "epoch " << (epoch + 1) << ": rms error "
+                  << (positions ? std::sqrt(totalError / positions) * SCALE : 0.0) << std::endl;
+    }
+
+    // Activations are scaled to [0, ACTIVATION_MAX], outputs to search units
+    NeuralEvaluator::Weights weights;
+    const float activationScale = NeuralEvaluator::ACTIVATION_MAX;
+    const float outputScale = SCALE * NeuralEvaluator::OUTPUT_DIVISOR / activationScale;
+    for (int feature = 0; feature < INPUTS; ++feature) {
+        for (int unit = 0; unit < HIDDEN; ++unit) {
+            weights.inputWeights[feature * HIDDEN + unit] = quantize(net.inputWeights[feature][unit], activationScale);
+        }
+    }
+    for (int unit = 0; unit < HIDDEN; ++unit) {
+        weights.hiddenBias[unit] = quantize(net.hiddenBias[unit], activationScale);
+        weights.outputWeights[unit] = quantize(net.outputWeights[unit], outputScale);
+    }
+    weights.outputBias = static_cast<std::int32_t>(std::round(net.outputBias * SCALE * NeuralEvaluator::OUTPUT_DIVISOR));
+
+    if (!NeuralEvaluator(weights).save(output)) {
+        std::cerr << "Error: Could not write weights file: " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote weights to " << output << std::endl;
+    return 0;
+}